@@ -28,3 +28,7 @@ if(SERAR_WITH_JSON)
     target_link_libraries(AllArchives INTERFACE $<TARGET_NAME:JSON>)
     target_compile_definitions(AllArchives INTERFACE SERAR_HAS_JSON)
 endif()
+
+if(SERAR_WITH_FIELDOBSERVER)
+    target_compile_definitions(Core INTERFACE SERAR_HAS_FIELD_OBSERVER)
+endif()
@@ -0,0 +1,552 @@
+///---------------------------------------------------------------------------------------------------
+// file:		SerAr_Bench.cpp
+//
+// summary: 	Save/load benchmark for all archives enabled in AllArchiveIncludes.hpp
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+//
+// Usage: SerAr_Bench [--records N] [--vector-mb N] [--matrix-size N] [--repeat N] [--dir path] [--output file]
+// Writes one JSON document with one entry per archive and payload to stdout (or --output).
+// peak_rss_bytes is measured per entry where the peak can be reset (Linux); process_peak_rss_bytes covers the whole run.
+///---------------------------------------------------------------------------------------------------
+#include <SerAr.hpp>
+
+#include "SerAr_ExampleStructs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+///-------------------------------------------------------------------------------------------------
+/// Allocation counting. Replaces all global operator new/delete overloads of this executable.
+/// Allocation and release happen in non-inlined helpers so that the compiler never sees
+/// std::free being called on the result of an operator new (-Wmismatched-new-delete).
+///-------------------------------------------------------------------------------------------------
+#if defined(_MSC_VER)
+#define SERAR_BENCH_NOINLINE __declspec(noinline)
+#else
+#define SERAR_BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+    std::atomic<std::size_t> allocation_count{ 0 };
+    std::atomic<std::size_t> allocation_bytes{ 0 };
+
+    SERAR_BENCH_NOINLINE void* countedAllocate(std::size_t size, std::size_t alignment) noexcept
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+        if (size == 0)
+            size = 1;
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return std::malloc(size);
+#if defined(_WIN32)
+        return _aligned_malloc(size, alignment);
+#else
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+    SERAR_BENCH_NOINLINE void countedFree(void* ptr, std::size_t alignment) noexcept
+    {
+#if defined(_WIN32)
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            _aligned_free(ptr);
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        std::free(ptr);
+    }
+    void* countedNew(std::size_t size, std::size_t alignment)
+    {
+        if (void* ptr = countedAllocate(size, alignment))
+            return ptr;
+        throw std::bad_alloc{};
+    }
+    constexpr std::size_t default_alignment{ __STDCPP_DEFAULT_NEW_ALIGNMENT__ };
+}
+
+void* operator new(std::size_t size) { return countedNew(size, default_alignment); }
+void* operator new[](std::size_t size) { return countedNew(size, default_alignment); }
+void* operator new(std::size_t size, std::align_val_t al) { return countedNew(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return countedNew(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size, default_alignment); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size, default_alignment); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return countedAllocate(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return countedAllocate(size, static_cast<std::size_t>(al)); }
+void operator delete(void* ptr) noexcept { countedFree(ptr, default_alignment); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr, default_alignment); }
+void operator delete(void* ptr, std::size_t) noexcept { countedFree(ptr, default_alignment); }
+void operator delete[](void* ptr, std::size_t) noexcept { countedFree(ptr, default_alignment); }
+void operator delete(void* ptr, std::align_val_t al) noexcept { countedFree(ptr, static_cast<std::size_t>(al)); }
+void operator delete[](void* ptr, std::align_val_t al) noexcept { countedFree(ptr, static_cast<std::size_t>(al)); }
+void operator delete(void* ptr, std::size_t, std::align_val_t al) noexcept { countedFree(ptr, static_cast<std::size_t>(al)); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t al) noexcept { countedFree(ptr, static_cast<std::size_t>(al)); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr, default_alignment); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr, default_alignment); }
+void operator delete(void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept { countedFree(ptr, static_cast<std::size_t>(al)); }
+void operator delete[](void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept { countedFree(ptr, static_cast<std::size_t>(al)); }
+
+// Record without strings for archives which cannot load containers of strings
+struct flattest {
+    int myint{ 3 };
+    double mydouble{ 5.35116151 };
+    std::vector<double> myvector{ 3, 5, 6 };
+};
+template<SerAr::IsArchive Archive>
+void serialize(flattest& val, Archive& ar) {
+    ar(Archives::createNamedValue("myint", val.myint));
+    ar(Archives::createNamedValue("mydouble", val.mydouble));
+    ar(Archives::createNamedValue("myvector", val.myvector));
+}
+
+inline bool operator==(const flattest& lhs, const flattest& rhs) { return lhs.myint == rhs.myint && lhs.mydouble == rhs.mydouble && lhs.myvector == rhs.myvector; }
+inline bool operator==(const othertest& lhs, const othertest& rhs) { return lhs.mydouble == rhs.mydouble && lhs.myvector == rhs.myvector; }
+inline bool operator==(const test& lhs, const test& rhs)
+{
+    return lhs.myint == rhs.myint && lhs.myarray == rhs.myarray && lhs.mystring == rhs.mystring
+        && lhs.myvecnested == rhs.myvecnested && lhs.mynested == rhs.mynested;
+}
+
+namespace SerAr::Bench {
+
+    struct Settings {
+        std::size_t records{ 10000 };
+        std::size_t vector_mb{ 100 };
+        std::size_t matrix_size{ 2048 };
+        std::size_t repeat{ 1 };
+        std::filesystem::path directory{ std::filesystem::temp_directory_path() };
+        std::filesystem::path output{};
+    };
+
+    struct Measurement {
+        double seconds{ 0.0 };
+        std::size_t allocations{ 0 };
+        std::size_t allocated_bytes{ 0 };
+    };
+
+    struct Result {
+        std::string_view archive;
+        std::string_view payload;
+        std::string_view record_type;
+        std::size_t records{ 0 };
+        std::size_t payload_bytes{ 0 };
+        std::size_t file_bytes{ 0 };
+        Measurement save{};
+        std::optional<Measurement> load{};
+        bool verified{ false };
+        std::optional<std::size_t> namedvalue_bytes{};  // Allocated by wrapping the payload into a temporary NamedValue
+        std::optional<std::size_t> peak_rss_bytes{};    // Only if the peak can be reset per entry (Linux)
+    };
+
+    inline std::size_t peakRSS() noexcept
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS pmc{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+            return static_cast<std::size_t>(pmc.PeakWorkingSetSize);
+        return 0;
+#else
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+    }
+
+    // Resets the peak resident set size of the process to the current one. Needs Linux >= 4.0;
+    // getrusage() cannot be reset, so the peak is read from VmHWM afterwards.
+    inline bool resetPeakRSS() noexcept
+    {
+#if defined(__linux__)
+        std::ofstream clear_refs{ "/proc/self/clear_refs" };
+        clear_refs << "5";
+        clear_refs.flush();
+        return static_cast<bool>(clear_refs);
+#else
+        return false;
+#endif
+    }
+
+    inline std::optional<std::size_t> resettablePeakRSS()
+    {
+#if defined(__linux__)
+        std::ifstream status{ "/proc/self/status" };
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.starts_with("VmHWM:"))
+                return static_cast<std::size_t>(std::stoull(line.substr(6))) * 1024;
+        }
+#endif
+        return std::nullopt;
+    }
+
+    template<typename Func>
+    Measurement measure(Func&& func)
+    {
+        const auto count_before = allocation_count.load(std::memory_order_relaxed);
+        const auto bytes_before = allocation_bytes.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        std::forward<Func>(func)();
+        const auto stop = std::chrono::steady_clock::now();
+        return Measurement{ std::chrono::duration<double>(stop - start).count(),
+                            allocation_count.load(std::memory_order_relaxed) - count_before,
+                            allocation_bytes.load(std::memory_order_relaxed) - bytes_before };
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// Archive construction from the archive traits (constructor argument order differs per archive)
+    ///-------------------------------------------------------------------------------------------------
+    template<ArchiveTypeEnum value>
+    auto makeOutputArchive(const std::filesystem::path& path)
+    {
+        using traits = output_archive_traits<value>;
+        using archive_type = typename traits::archive_type;
+        using option_type = typename traits::option_type;
+        if constexpr (std::constructible_from<archive_type, const std::filesystem::path&, const option_type&>)
+            return std::make_unique<archive_type>(path, traits::overwrite_option);
+        else if constexpr (std::constructible_from<archive_type, const option_type&, const std::filesystem::path&>)
+            return std::make_unique<archive_type>(traits::overwrite_option, path);
+        else
+            return std::make_unique<archive_type>(path);
+    }
+
+    template<ArchiveTypeEnum value>
+    auto makeInputArchive(const std::filesystem::path& path)
+    {
+        using traits = input_archive_traits<value>;
+        using archive_type = typename traits::archive_type;
+        using option_type = typename traits::option_type;
+        if constexpr (std::constructible_from<archive_type, const std::filesystem::path&, const option_type&>)
+            return std::make_unique<archive_type>(path, option_type{});
+        else if constexpr (std::constructible_from<archive_type, const option_type&, const std::filesystem::path&>)
+            return std::make_unique<archive_type>(option_type{}, path);
+        else
+            return std::make_unique<archive_type>(path);
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// What each archive can store. Records use the nested test struct where containers of structs
+    /// are supported and othertest otherwise.
+    ///-------------------------------------------------------------------------------------------------
+    template<ArchiveTypeEnum value>
+    struct capabilities {
+        using record_type = othertest;
+        static constexpr std::string_view record_name{ "othertest" };
+        static constexpr bool records = true;
+        static constexpr bool bulk = true;
+    };
+    template<>
+    struct capabilities<ArchiveTypeEnum::JSON> {
+        using record_type = test;
+        static constexpr std::string_view record_name{ "test" };
+        static constexpr bool records = true;
+        static constexpr bool bulk = true;
+    };
+    template<>
+    struct capabilities<ArchiveTypeEnum::ConfigFile> {
+        using record_type = flattest;           // Containers of strings cannot be loaded
+        static constexpr std::string_view record_name{ "flattest" };
+        static constexpr bool records = true;
+        static constexpr bool bulk = false;     // Text key/value file; not meant for bulk numeric data
+    };
+    template<>
+    struct capabilities<ArchiveTypeEnum::MATLAB> {
+        using record_type = othertest;
+        static constexpr std::string_view record_name{ "othertest" };
+        static constexpr bool records = false;  // No support for containers of strings
+        static constexpr bool bulk = true;
+    };
+
+    // Makes every record distinct so that the load can be verified
+    inline void tagRecord(flattest& val, std::size_t index)
+    {
+        val.myint = static_cast<int>(index);
+        val.mydouble = static_cast<double>(index);
+    }
+    inline void tagRecord(othertest& val, std::size_t index) { val.mydouble = static_cast<double>(index); }
+    inline void tagRecord(test& val, std::size_t index)
+    {
+        val.myint = static_cast<int>(index);
+        tagRecord(val.mynested, index);
+    }
+
+    inline std::size_t payloadBytes(const flattest& val) { return sizeof(val.myint) + sizeof(val.mydouble) + val.myvector.size() * sizeof(double); }
+    inline std::size_t payloadBytes(const othertest& val)
+    {
+        std::size_t bytes{ sizeof(val.mydouble) };
+        for (const auto& str : val.myvector)
+            bytes += str.size();
+        return bytes;
+    }
+    inline std::size_t payloadBytes(const test& val)
+    {
+        std::size_t bytes{ sizeof(val.myint) + sizeof(val.myarray) + val.mystring.size() + payloadBytes(val.mynested) };
+        for (const auto& nested : val.myvecnested)
+            bytes += payloadBytes(nested);
+        return bytes;
+    }
+
+    template<ArchiveTypeEnum value>
+    Result runRecords(const Settings& settings, const std::filesystem::path& path)
+    {
+        using caps = capabilities<value>;
+        using record_type = typename caps::record_type;
+        Result result{ ArchiveTypeEnumMap[value], "records", caps::record_name, settings.records };
+
+        std::vector<record_type> records(settings.records);
+        for (std::size_t i = 0; i < records.size(); ++i)
+            tagRecord(records[i], i);
+        std::vector<std::string> names(settings.records);
+        for (std::size_t i = 0; i < names.size(); ++i)
+            names[i] = "record_" + std::to_string(i);
+        for (const auto& record : records)
+            result.payload_bytes += payloadBytes(record);
+
+        result.save = measure([&] {
+            auto ar = makeOutputArchive<value>(path);
+            for (std::size_t i = 0; i < records.size(); ++i)
+                (*ar)(Archives::createNamedValue(std::string_view{ names[i] }, records[i]));
+        });
+        result.file_bytes = std::filesystem::file_size(path);
+
+        if constexpr (is_input_archive_available_v<value>) {
+            std::vector<record_type> loaded(settings.records);
+            result.load = measure([&] {
+                auto ar = makeInputArchive<value>(path);
+                for (std::size_t i = 0; i < loaded.size(); ++i)
+                    (*ar)(Archives::createNamedValue(std::string_view{ names[i] }, loaded[i]));
+            });
+            result.verified = (loaded == records);
+        }
+        return result;
+    }
+
+    template<ArchiveTypeEnum value>
+    Result runVector(const Settings& settings, const std::filesystem::path& path)
+    {
+        Result result{ ArchiveTypeEnumMap[value], "vector<double>", "double", 1 };
+        const std::size_t size = settings.vector_mb * 1024 * 1024 / sizeof(double);
+        result.payload_bytes = size * sizeof(double);
+
+        std::vector<double> payload(size);
+        for (std::size_t i = 0; i < size; ++i)
+            payload[i] = static_cast<double>(i);
+        const auto first = payload.front();
+        const auto last = payload.back();
+
+        // A temporary NamedValue owning the payload must neither copy it on creation nor in getValue()
+        const auto* const storage = payload.data();
+        const auto wrap = measure([&] {
+            auto named = Archives::createNamedValue("vector", std::move(payload));
+            const auto& cnamed = named;
+            if (cnamed.getValue().data() != storage)
+                throw std::logic_error{ "NamedValue::getValue() copied the payload!" };
+            payload = std::move(named.getValue());
+        });
+        result.namedvalue_bytes = wrap.allocated_bytes;
+
+        // Through a temporary NamedValue owning the payload as well
+        result.save = measure([&] {
+            auto ar = makeOutputArchive<value>(path);
+            (*ar)(Archives::createNamedValue("vector", std::move(payload)));
+        });
+        result.file_bytes = std::filesystem::file_size(path);
+
+        if constexpr (is_input_archive_available_v<value>) {
+            std::vector<double> loaded;
+            result.load = measure([&] {
+                auto ar = makeInputArchive<value>(path);
+                (*ar)(Archives::createNamedValue("vector", loaded));
+            });
+            result.verified = loaded.size() == size && loaded.front() == first && loaded.back() == last
+                              && *result.namedvalue_bytes < result.payload_bytes;
+        }
+        return result;
+    }
+
+    template<ArchiveTypeEnum value>
+    Result runMatrix(const Settings& settings, const std::filesystem::path& path)
+    {
+        Result result{ ArchiveTypeEnumMap[value], "Eigen::MatrixXd", "double", 1 };
+        const auto n = static_cast<Eigen::Index>(settings.matrix_size);
+        const Eigen::MatrixXd payload = Eigen::MatrixXd::Random(n, n);
+        result.payload_bytes = static_cast<std::size_t>(payload.size()) * sizeof(double);
+
+        result.save = measure([&] {
+            auto ar = makeOutputArchive<value>(path);
+            (*ar)(Archives::createNamedValue("matrix", payload));
+        });
+        result.file_bytes = std::filesystem::file_size(path);
+
+        if constexpr (is_input_archive_available_v<value>) {
+            Eigen::MatrixXd loaded(n, n);
+            result.load = measure([&] {
+                auto ar = makeInputArchive<value>(path);
+                (*ar)(Archives::createNamedValue("matrix", loaded));
+            });
+            result.verified = loaded.isApprox(payload);
+        }
+        return result;
+    }
+
+    template<ArchiveTypeEnum value>
+    void runArchive(const Settings& settings, std::vector<Result>& results)
+    {
+        using caps = capabilities<value>;
+        const auto path = settings.directory / ("SerAr_Bench" + std::string{ archive_traits<value>::defaut_file_extension.empty() ? "" : "." }
+                                                + std::string{ archive_traits<value>::defaut_file_extension });
+        // The peak RSS is process wide and only grows; without a reset before each entry it would
+        // merely repeat the largest entry run so far.
+        const auto store = [&](auto&& run_entry) {
+            const bool reset = resetPeakRSS();
+            auto result = run_entry();
+            if (reset)
+                result.peak_rss_bytes = resettablePeakRSS();
+            results.push_back(std::move(result));
+            std::filesystem::remove(path);
+        };
+        for (std::size_t run = 0; run < settings.repeat; ++run) {
+            if constexpr (caps::records)
+                store([&] { return runRecords<value>(settings, path); });
+            if constexpr (caps::bulk) {
+                store([&] { return runVector<value>(settings, path); });
+                store([&] { return runMatrix<value>(settings, path); });
+            }
+        }
+    }
+
+    static constexpr const auto bench_archives = available_output_archives_from_array<AllArchiveTypeEnums>;
+
+    template<std::size_t... Is>
+    void runAll(const Settings& settings, std::vector<Result>& results, std::index_sequence<Is...>)
+    {
+        (runArchive<bench_archives[Is]>(settings, results), ...);
+    }
+
+    inline void writeMeasurement(std::ostream& os, const Measurement& m, const Result& r)
+    {
+        const double mb = static_cast<double>(r.payload_bytes) / (1024.0 * 1024.0);
+        os << "{ \"seconds\": " << m.seconds
+           << ", \"MB_per_s\": " << (m.seconds > 0 ? mb / m.seconds : 0.0)
+           << ", \"records_per_s\": " << (m.seconds > 0 ? static_cast<double>(r.records) / m.seconds : 0.0)
+           << ", \"allocations\": " << m.allocations
+           << ", \"allocated_bytes\": " << m.allocated_bytes << " }";
+    }
+
+    inline void writeJSON(std::ostream& os, const Settings& settings, const std::vector<Result>& results)
+    {
+        os << "{\n  \"settings\": { \"records\": " << settings.records << ", \"vector_mb\": " << settings.vector_mb
+           << ", \"matrix_size\": " << settings.matrix_size << ", \"repeat\": " << settings.repeat << " },\n";
+        os << "  \"results\": [";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            os << (i == 0 ? "\n" : ",\n");
+            os << "    { \"archive\": \"" << r.archive << "\", \"payload\": \"" << r.payload
+               << "\", \"record_type\": \"" << r.record_type << "\", \"records\": " << r.records
+               << ", \"payload_bytes\": " << r.payload_bytes << ", \"file_bytes\": " << r.file_bytes
+               << ",\n      \"save\": ";
+            writeMeasurement(os, r.save, r);
+            os << ",\n      \"load\": ";
+            if (r.load)
+                writeMeasurement(os, *r.load, r);
+            else
+                os << "null";
+            if (r.namedvalue_bytes)
+                os << ",\n      \"namedvalue_allocated_bytes\": " << *r.namedvalue_bytes;
+            os << ",\n      \"verified\": " << (r.verified ? "true" : "false") << ", \"peak_rss_bytes\": ";
+            if (r.peak_rss_bytes)
+                os << *r.peak_rss_bytes;
+            else
+                os << "null";
+            os << " }";
+        }
+        // Resetting the peak per entry resets the one reported by getrusage() as well
+        std::size_t process_peak = peakRSS();
+        for (const auto& r : results)
+            process_peak = std::max(process_peak, r.peak_rss_bytes.value_or(0));
+        os << "\n  ],\n  \"process_peak_rss_bytes\": " << process_peak << "\n}\n";
+    }
+
+    inline Settings parseArguments(int argc, char** argv)
+    {
+        Settings settings{};
+        for (int i = 1; i < argc; i += 2) {
+            const std::string_view arg{ argv[i] };
+            if (i + 1 == argc)
+                throw std::invalid_argument{ "Missing value for argument: " + std::string{ arg } };
+            const char* value = argv[i + 1];
+            if (arg == "--records")
+                settings.records = std::stoull(value);
+            else if (arg == "--vector-mb") {
+                settings.vector_mb = std::stoull(value);
+                if (settings.vector_mb == 0)
+                    throw std::invalid_argument{ "--vector-mb needs to be at least 1!" };
+            }
+            else if (arg == "--matrix-size")
+                settings.matrix_size = std::stoull(value);
+            else if (arg == "--repeat")
+                settings.repeat = std::stoull(value);
+            else if (arg == "--dir")
+                settings.directory = value;
+            else if (arg == "--output")
+                settings.output = value;
+            else
+                throw std::invalid_argument{ "Unknown argument: " + std::string{ arg } };
+        }
+        return settings;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace SerAr::Bench;
+    try {
+        const auto settings = parseArguments(argc, argv);
+        std::vector<Result> results;
+        runAll(settings, results, std::make_index_sequence<bench_archives.size()>{});
+        if (settings.output.empty()) {
+            writeJSON(std::cout, settings, results);
+        }
+        else {
+            std::ofstream file{ settings.output };
+            writeJSON(file, settings, results);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "SerAr_Bench failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -35,14 +35,14 @@ namespace Archives
 			template<typename T>
 		inline std::enable_if_t<!helpers::traits::use_cereal_save_v<T, Archive>> save(const NamedValue<T>& value)
 		{
-			static_cast<Archive&>(*this)(cereal::make_nvp(value.getName(), helpers::CerealAdapter<T, WrapperArchive>{value.getValue()}));
+			static_cast<Archive&>(*this)(cereal::make_nvp(std::string{ value.getName() }, helpers::CerealAdapter<typename NamedValue<T>::const_reference, WrapperArchive>{value.getValue()}));
 		};
 
 		// Output Endpoin; cereal knows how to write the type!
 		template <typename T>
 		inline std::enable_if_t<helpers::traits::use_cereal_save_v<T, Archive>> save(const NamedValue<T>& value)
 		{
-			static_cast<Archive&>(*this)(cereal::make_nvp(value.getName(), value.getValue()));
+			static_cast<Archive&>(*this)(cereal::make_nvp(std::string{ value.getName() }, value.getValue()));
 		}
 
 		template<typename T>
@@ -82,14 +82,14 @@ namespace Archives
 			template<typename T>
 		inline std::enable_if_t<!helpers::traits::use_cereal_load_v<T, Archive>> load(const NamedValue<T>& value)
 		{
-			static_cast<Archive&>(*this)(cereal::make_nvp(value.getName(), helpers::CerealAdapter<T, WrapperArchive>{value.getValue()}));
+			static_cast<Archive&>(*this)(cereal::make_nvp(std::string{ value.getName() }, helpers::CerealAdapter<typename NamedValue<T>::const_reference, WrapperArchive>{value.getValue()}));
 		};
 
 		// Input Endpoint; cereal knows how to load the type!
 		template <typename T>
 		inline std::enable_if_t<helpers::traits::use_cereal_load_v<T, Archive>> load(const NamedValue<T>& value)
 		{
-			static_cast<Archive&>(*this)(cereal::make_nvp(value.getName(), value.getValue()));
+			static_cast<Archive&>(*this)(cereal::make_nvp(std::string{ value.getName() }, value.getValue()));
 		}
 
 		template<typename T>
@@ -19,10 +19,15 @@
 #include <map>
 #include <iosfwd>
 #include <string>
+#include <string_view>
+#include <memory_resource>
+#include <functional>
 #include <regex>
 #include <complex>
 #include <exception>
 #include <cassert>
+#include <iterator>
+#include <span>
 
 //#ifdef EIGEN_CORE_H
 //#include <Eigen/Core>
@@ -32,6 +37,8 @@
 #include <MyCEL/basics/BasicMacros.h>
 #include <MyCEL/basics/BasicIncludes.h>
 
+#include <SerAr/Core/ArchiveMemoryResource.h>
+#include <SerAr/Core/ArrayView.h>
 #include <SerAr/Core/NamedValue.h>
 #include <SerAr/Core/InputArchive.h>
 #include <SerAr/Core/OutputArchive.h>
@@ -578,6 +585,36 @@ namespace Archives
             }
 #endif
 
+            /// <summary>	Convert a braced string representation into the elements of a view (row-major); nested braces for views of higher rank. </summary>
+            template<typename Iterator>
+            static inline void array_from_string(std::string& str, Iterator& position, std::span<const std::size_t> extents)
+            {
+                using T = std::iter_value_t<Iterator>;
+                if (extents.empty())
+                {
+                    *position++ = from_string_selector<T>(str);
+                    return;
+                }
+                removeBraces(str);
+                std::size_t count{ 0 };
+                if (str.find_first_not_of(" \t\v") != str.npos)
+                {
+                    for (std::size_t commapos{ findNextCommaSeperator(str) }; ++count <= extents.front(); commapos = findNextCommaSeperator(str))
+                    {
+                        std::string element{ str.substr(0, commapos) };
+                        if (extents.size() == 1)
+                            *position++ = from_string_selector<T>(element);
+                        else
+                            array_from_string(element, position, extents.subspan(1));
+                        if (commapos == str.npos)
+                            break;
+                        str.erase(0, commapos + SpecialCharacters::seperator.size());
+                    }
+                }
+                if (count != extents.front())
+                    throw std::runtime_error{ "Number of elements does not fit the extents of the view it is loaded into!" };
+            }
+
         private:
             static inline bool removeBraces(std::string &value)
             {
@@ -722,7 +759,7 @@ namespace Archives
         {
         public:
 
-            static void checkSyntax(const std::string &section, const std::string &key, const std::string &value);
+            static void checkSyntax(std::string_view section, std::string_view key, const std::string &value);
             ///-------------------------------------------------------------------------------------------------
             /// <summary>	Selects the correct to_string implementation for the given type of value. </summary>
             ///
@@ -815,6 +852,28 @@ namespace Archives
                 return sstr.str();
             }
 
+            /// <summary>	Append the elements of a view (row-major) as braced string representation; nested braces for views of higher rank. </summary>
+            template<typename Iterator>
+            static inline void array_to_string(std::string& str, Iterator& position, std::span<const std::size_t> extents)
+            {
+                if (extents.empty())
+                {
+                    str += to_string_selector(*position++);
+                    return;
+                }
+                str += SpecialCharacters::openbracket;
+                for (std::size_t i = 0; i < extents.front(); ++i)
+                {
+                    if (i != 0)
+                        str.append(SpecialCharacters::seperator).append(" ");
+                    if (extents.size() == 1)
+                        str += to_string_selector(*position++);
+                    else
+                        array_to_string(str, position, extents.subspan(1));
+                }
+                str += SpecialCharacters::closebracket;
+            }
+
             /// <summary>	Convert pairs into a string representation. </summary>
             template <typename T>
             static inline std::enable_if_t<std::is_same<T, std::pair<typename T::x, typename T::y>>::value, std::string> to_string(const T &val)
@@ -867,8 +926,9 @@ namespace Archives
             friend class ConfigFile_OutputArchive;
             friend class ConfigFile_InputArchive;
         protected:
-            typedef std::map<std::string, std::string> keyvalues;
-            typedef std::map<std::string, keyvalues> sections;
+            // Transparent comparators so that keys can be looked up by std::string_view without allocating
+            typedef std::map<std::string, std::string, std::less<>> keyvalues;
+            typedef std::map<std::string, keyvalues, std::less<>> sections;
 
             sections _contents{};	//Contents of the CFG
         public:
@@ -913,33 +973,37 @@ namespace Archives
         class Logic
         {
         private:
-            std::stack<std::string> NameStack{};
-            std::string currentsection{};	// Cache for the current Section //So that we do not have to build it!
-            const std::string SectionSeperator{ "." };
+            pmr_stack<std::string_view> NameStack;	// Names are only referenced; they outlive the setCurrKey/resetCurrKey pair
+            std::pmr::string currentsection;	// Cache for the current Section //So that we do not have to build it!
+            static constexpr std::string_view SectionSeperator{ "." };
 
             /// <summary>	Appends the curr key to the current section </summary>
             inline void appendCurrKeyToSec()
             {
                 if (currentsection.empty())
                 {
-                    const std::string tmp = NameStack.top();
-                    currentsection = tmp;
+                    currentsection.assign(NameStack.top());
                 }
                 else
                 {
-                    currentsection.append(SectionSeperator + NameStack.top());
+                    currentsection.append(SectionSeperator).append(NameStack.top());
                 }
             }
 
 
 
         public:
+            explicit Logic(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                : NameStack(resource), currentsection(resource) {}
+
+            inline std::pmr::memory_resource* getMemoryResource() const noexcept { return currentsection.get_allocator().resource(); }
+
             ///-------------------------------------------------------------------------------------------------
             /// <summary>	Sets current key. </summary>
             ///
             /// <param name="str">	The key string. </param>
             ///-------------------------------------------------------------------------------------------------
-            inline void setCurrKey(const std::string& str)
+            inline void setCurrKey(std::string_view str)
             {
                 if (!NameStack.empty())
                 {
@@ -962,14 +1026,15 @@ namespace Archives
                 }
             }
 
-            inline const std::string& getSection() noexcept { return currentsection; }
-            inline const std::string& getKey() noexcept { return NameStack.top(); }
+            inline std::string_view getSection() const noexcept { return currentsection; }
+            inline std::string_view getKey() noexcept { return NameStack.top(); }
         };
     };
 
     class ConfigFile_Options
     {
-
+    public:
+        std::pmr::memory_resource* MemoryResource{ nullptr };	// Current section and key names; nullptr = arena owned by the archive
     };
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Configuration file output archive. </summary>
@@ -982,8 +1047,8 @@ namespace Archives
         template <class Default, class AlwaysVoid, template<class...> class Op, class... Args> friend struct stdext::DETECTOR;
     public:
         using Options = ConfigFile_Options;
-        ConfigFile_OutputArchive(std::ostream& stream);
-        ConfigFile_OutputArchive(const std::filesystem::path &path);
+        ConfigFile_OutputArchive(std::ostream& stream, const Options& options = Options{});
+        ConfigFile_OutputArchive(const std::filesystem::path &path, const Options& options = Options{});
         ~ConfigFile_OutputArchive();
 
         //ALLOW_DEFAULT_MOVE_AND_ASSIGN(ConfigFile_OutputArchive)
@@ -1001,14 +1066,35 @@ namespace Archives
         template<typename T> 
         inline std::enable_if_t<traits::use_to_string_v<T, ConfigFile::toString, ConfigFile_OutputArchive > > save(const T& val)
         {
-            const std::string valstr{ ConfigFile::toString::to_string_selector(val) };
-            ConfigFile::toString::checkSyntax(ConfigLogic.getSection(), ConfigLogic.getKey(), valstr);
-            mStorage._contents[ConfigLogic.getSection()][ConfigLogic.getKey()] = valstr;
+            storeValue(ConfigFile::toString::to_string_selector(val));
+        }
+
+        // Views (std::span/std::mdspan) are written element by element as braced list (nested for views of higher rank)
+        template<typename T> requires (SerAr::IsArrayView<std::remove_cvref_t<T>>)
+        inline void save(const Archives::NamedValue<T>& value)
+        {
+            const auto data = arrayViewData(value.getValue());
+            const auto extents = arrayViewExtents(value.getValue());
+            std::string valstr;
+            auto position = data.begin();
+            ConfigFile::toString::array_to_string(valstr, position, extents);
+            ConfigLogic.setCurrKey(value.getName());
+            storeValue(valstr);
+            ConfigLogic.resetCurrKey();
         }
 
+        // Group interface (see SerAr::HasGroupInterface); same as saving a NamedValue holding a struct
+        inline void beginGroup(std::string_view name) { ConfigLogic.setCurrKey(name); }
+        inline void endGroup() { ConfigLogic.resetCurrKey(); }
+
         inline const ConfigFile::Storage& getStorage() const noexcept { return mStorage; }
+
+        // Writes the current contents to the file (replacing an earlier flush); only for archives opened from a path.
+        // Throws if the file cannot be written. The destructor only writes again if the contents changed since.
+        void flush();
     protected:
-        ConfigFile::Logic ConfigLogic{};
+        ArchiveMemoryResource mMemory;
+        ConfigFile::Logic ConfigLogic{ mMemory.get() };
     
     private:
         //std::string currentsection{}; // Cache for the current Section
@@ -1021,8 +1107,29 @@ namespace Archives
         std::ostream &mOutputstream;
             
         ConfigFile::Storage mStorage;
+        std::filesystem::path mPath{};
+        bool mWritten{ false };
+        bool mModified{ false };    // Changed since the last write
+
+        //Stores the value string under the current section and key
+        void storeValue(const std::string& valstr)
+        {
+            ConfigFile::toString::checkSyntax(ConfigLogic.getSection(), ConfigLogic.getKey(), valstr);
+            const auto sectionname{ ConfigLogic.getSection() };
+            auto sectionit = mStorage._contents.find(sectionname);
+            if (sectionit == mStorage._contents.end())
+                sectionit = mStorage._contents.try_emplace(std::string{ sectionname }).first;
+            auto& section{ sectionit->second };
+            const auto key{ ConfigLogic.getKey() };
+            mModified = true;
+            if (auto it = section.find(key); it != section.end())
+                it->second = valstr;
+            else
+                section.emplace(std::string{ key }, valstr);
+        }
 
         std::ofstream& createFileStream(const std::filesystem::path &path);
+        void writeStorage();
     };
 
     
@@ -1037,9 +1144,9 @@ namespace Archives
         
     public:
         using Options = ConfigFile_Options;
-        ConfigFile_InputArchive(std::istream& stream);
-        ConfigFile_InputArchive(ConfigFile::Storage storage);
-        ConfigFile_InputArchive(const std::filesystem::path &path);
+        ConfigFile_InputArchive(std::istream& stream, const Options& options = Options{});
+        ConfigFile_InputArchive(ConfigFile::Storage storage, const Options& options = Options{});
+        ConfigFile_InputArchive(const std::filesystem::path &path, const Options& options = Options{});
         ConfigFile_InputArchive(ConfigFile_InputArchive&& CFG);
         ~ConfigFile_InputArchive();
 
@@ -1070,11 +1177,71 @@ namespace Archives
             ConfigLogic.resetCurrKey();
         }
 
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Loads a single nested value by looking up its section and key directly. </summary>
+        ///
+        /// <param name="path">	Names of the NamedValues from the root separated by '.' (e.g. "mytest.mynested.mydouble"). </param>
+        ///-------------------------------------------------------------------------------------------------
+        template<typename T>
+        void load_path(std::string_view path, T& value)
+        {
+            if (path.empty())
+                throw std::runtime_error{ "Empty path given to load_path!" };
+            struct RestoreLogic {
+                ConfigFile::Logic& current;
+                ConfigFile::Logic previous;
+                explicit RestoreLogic(ConfigFile::Logic& logic) : current(logic), previous(std::exchange(logic, ConfigFile::Logic{ logic.getMemoryResource() })) {}
+                ~RestoreLogic() { current = std::move(previous); }
+            } restore{ ConfigLogic };
+
+            for (auto pos = path.find('.'); ; pos = path.find('.')) {
+                ConfigLogic.setCurrKey(path.substr(0, pos));
+                if (pos == path.npos)
+                    break;
+                path.remove_prefix(pos + 1);
+            }
+            this->operator()(value);
+        }
+
         template<typename T>
         std::enable_if_t<traits::use_from_string_v<std::decay_t<T> , ConfigFile::fromString, ConfigFile_InputArchive> > load(T&& val)
-        {			
-            const auto& currentsection{ ConfigLogic.getSection() };
-            const auto& currentkey{ ConfigLogic.getKey() };
+        {
+            loadValue([&val](std::string& valstr) { val = ConfigFile::fromString::from_string_selector<T>(valstr); });
+        }
+
+        // Views (std::span/std::mdspan) are filled element by element from the braced list written by the output archive
+        template<typename T> requires (SerAr::IsArrayView<std::remove_cvref_t<T>>)
+        void load(Archives::NamedValue<T>& value)
+        {
+            const auto data = arrayViewData(value.getValue());
+            static_assert(!std::is_const_v<typename decltype(data)::element_type>, "Cannot load into a view of const elements!");
+            const auto extents = arrayViewExtents(value.getValue());
+            ConfigLogic.setCurrKey(value.getName());
+            loadValue([&data, &extents](std::string& valstr) {
+                auto position = data.begin();
+                ConfigFile::fromString::array_from_string(valstr, position, extents);
+            });
+            ConfigLogic.resetCurrKey();
+        }
+
+        inline const ConfigFile::Storage& getStorage() const noexcept { return mStorage; }
+
+        // Checks for a key or (nested) section of the given name at the current position (see SerAr::HasFieldLookup)
+        bool contains(std::string_view name);
+    protected:
+        ArchiveMemoryResource mMemory;
+        ConfigFile::Logic ConfigLogic{ mMemory.get() };
+    private:
+        bool mStreamOwner{ false };
+        std::istream& mInputstream;
+        ConfigFile::Storage mStorage;
+
+        //Looks up the value string of the current section and key and passes it to convert
+        template<typename Convert>
+        void loadValue(Convert&& convert)
+        {
+            const std::string_view currentsection{ ConfigLogic.getSection() };
+            const std::string_view currentkey{ ConfigLogic.getKey() };
 
             //const auto& nosec{ currentsection.empty() };
             //const auto& nokey{ currentkey.empty() };
@@ -1097,23 +1264,28 @@ namespace Archives
                 //TODO:: Empty Key
                 //if (nokey = currentkey.empty())
                 //	currentkey = typeid(std::decay_t<T>).name() + "_" + std::to_string(typecounter<std::decay_t<T>>)
-                std::string valstr{ res->second.at(currentkey) };
-                val = ConfigFile::fromString::from_string_selector<T>(valstr);
+                const auto keyval = res->second.find(currentkey);
+                if (keyval == res->second.end())
+                {
+                    throw ConfigFile::Parse_error{ ConfigFile::Parse_error::error_enum::Key_not_found };
+                }
+                std::string valstr{ keyval->second };
+                convert(valstr);
             }
             catch (ConfigFile::Parse_error &e)
             {
-                e.append("Section: "+ currentsection +"! Key: " + currentkey + "! ");
+                e.append("Section: "+ std::string{ currentsection } +"! Key: " + std::string{ currentkey } + "! ");
                 throw e;
             }
             catch (std::out_of_range &)
             {
                 auto e = ConfigFile::Parse_error{ ConfigFile::Parse_error::error_enum::Key_not_found };
-                e.append("Section: " + currentsection + "! Key: " + currentkey + "! ");
+                e.append("Section: " + std::string{ currentsection } + "! Key: " + std::string{ currentkey } + "! ");
                 throw e;
             }
             catch (std::runtime_error &e)
             {
-                const auto str{ std::string{ e.what() }+" Section: " + currentsection + "! Key: " + currentkey + "! " };
+                const auto str{ std::string{ e.what() }+" Section: " + std::string{ currentsection } + "! Key: " + std::string{ currentkey } + "! " };
                 std::runtime_error exp{ str };
                 throw exp;
             }
@@ -1124,14 +1296,6 @@ namespace Archives
             //	currentsection.clear();
         }
 
-        inline const ConfigFile::Storage& getStorage() const noexcept { return mStorage; }
-    protected:
-        ConfigFile::Logic ConfigLogic{};
-    private:
-        bool mStreamOwner{ false };
-        std::istream& mInputstream;
-        ConfigFile::Storage mStorage;
-
         std::ifstream& createFileStream(const std::filesystem::path &path);
         void SkipBOM(std::ifstream &in);
 
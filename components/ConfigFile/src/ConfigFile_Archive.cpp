@@ -269,16 +269,19 @@ void  ConfigFile::Storage::writeContentsToStream(std::ostream &stream) const
 ///ConfigFile::toString
 ///-------------------------------------------------------------------------------------------------
 
-void ConfigFile::toString::checkSyntax(const std::string& section, const std::string& key, const std::string& value)
+void ConfigFile::toString::checkSyntax(std::string_view section, std::string_view key, const std::string& value)
 {
-    const std::string s{ ' ' + key + " = " + value };
+    std::string s{ ' ' };
+    s.append(key).append(" = ").append(value);
     if (!FileParser::validKeyValueLine(s))
     {
-        throw std::runtime_error{ std::string{ "Key and\\or Value does not fullfill requirements for Configuration Archive. Key: " + key + " Value:" + value } };
+        throw std::runtime_error{ std::string{ "Key and\\or Value does not fullfill requirements for Configuration Archive. Key: " + std::string{ key } + " Value:" + value } };
     }
-    if (!FileParser::validSectionLine('[' + section + ']'))
+    std::string sec{ '[' };
+    sec.append(section).append("]");
+    if (!FileParser::validSectionLine(sec))
     {
-        throw std::runtime_error{ std::string{ "Section does not fullfill requirements for Configuration Archive. Section: " + section } };
+        throw std::runtime_error{ std::string{ "Section does not fullfill requirements for Configuration Archive. Section: " } + std::string{ section } };
     }
     return;
 }
@@ -291,12 +294,16 @@ void ConfigFile::toString::checkSyntax(const std::string& section, const std::st
 ///ConfigFile::Output Archive
 ///-------------------------------------------------------------------------------------------------
 
-ConfigFile_OutputArchive::ConfigFile_OutputArchive(std::ostream& stream) : OutputArchive(this), mOutputstream(stream), mStorage() {}
-ConfigFile_OutputArchive::ConfigFile_OutputArchive(const std::filesystem::path &path) : OutputArchive(this), mOutputstream(createFileStream(path)), mStorage() {}
+ConfigFile_OutputArchive::ConfigFile_OutputArchive(std::ostream& stream, const Options& options) : OutputArchive(this), mMemory(options.MemoryResource), mOutputstream(stream), mStorage() {}
+ConfigFile_OutputArchive::ConfigFile_OutputArchive(const std::filesystem::path &path, const Options& options) : OutputArchive(this), mMemory(options.MemoryResource), mOutputstream(createFileStream(path)), mStorage(), mPath(path) {}
 ConfigFile_OutputArchive::~ConfigFile_OutputArchive()
 {
-    mStorage.writeContentsToStream(mOutputstream);
-    mOutputstream << std::flush;
+    try
+    {
+        if (!mWritten || mModified) // Keep flushed contents if nothing changed since
+            writeStorage();
+    }
+    catch (...) {}
 
     if (mStreamOwner) 
     {
@@ -304,6 +311,33 @@ ConfigFile_OutputArchive::~ConfigFile_OutputArchive()
     }
 }
 
+void ConfigFile_OutputArchive::flush()
+{
+    if (!mStreamOwner)
+    {
+        throw std::runtime_error{ "Cannot flush configuration file! The archive does not own its stream!" };
+    }
+    writeStorage();
+}
+
+void ConfigFile_OutputArchive::writeStorage()
+{
+    if (mWritten) // Replace the previously written contents
+    {
+        auto& file = static_cast<std::ofstream&>(mOutputstream);
+        file.close();
+        file.open(mPath.string().c_str(), std::ios::out | std::ios::trunc);
+    }
+    mStorage.writeContentsToStream(mOutputstream);
+    mOutputstream << std::flush;
+    if (!mOutputstream)
+    {
+        throw std::runtime_error{ "Unable to write configuration file: '" + mPath.string() + "'" };
+    }
+    mWritten = true;
+    mModified = false;
+}
+
 std::ofstream& ConfigFile_OutputArchive::createFileStream(const std::filesystem::path &path)
 {
     if (!path.has_filename())
@@ -331,16 +365,16 @@ std::ofstream& ConfigFile_OutputArchive::createFileStream(const std::filesystem:
 ///-------------------------------------------------------------------------------------------------
 ///ConfigFile::Input Archive
 ///-------------------------------------------------------------------------------------------------
-ConfigFile_InputArchive::ConfigFile_InputArchive(std::istream &stream) : InputArchive(this), mInputstream(stream), mStorage()
+ConfigFile_InputArchive::ConfigFile_InputArchive(std::istream &stream, const Options& options) : InputArchive(this), mMemory(options.MemoryResource), mInputstream(stream), mStorage()
 {
     parseStream();
 }
 
-ConfigFile_InputArchive::ConfigFile_InputArchive(ConfigFile::Storage storage) : InputArchive(this), mInputstream(std::cin), mStorage(std::move(storage))
+ConfigFile_InputArchive::ConfigFile_InputArchive(ConfigFile::Storage storage, const Options& options) : InputArchive(this), mMemory(options.MemoryResource), mInputstream(std::cin), mStorage(std::move(storage))
 {
 }
 
-ConfigFile_InputArchive::ConfigFile_InputArchive(const std::filesystem::path &path) : InputArchive(this), mInputstream(createFileStream(path)), mStorage()
+ConfigFile_InputArchive::ConfigFile_InputArchive(const std::filesystem::path &path, const Options& options) : InputArchive(this), mMemory(options.MemoryResource), mInputstream(createFileStream(path)), mStorage()
 {
     parseStream();
 }
@@ -366,6 +400,36 @@ ConfigFile_InputArchive::~ConfigFile_InputArchive()
     }
 }
 
+bool ConfigFile_InputArchive::contains(std::string_view name)
+{
+    ConfigLogic.setCurrKey(name);
+    const std::string_view currentsection{ ConfigLogic.getSection() };
+    bool found{ false };
+    if (const auto section = mStorage._contents.find(currentsection); section != mStorage._contents.end())
+    {
+        found = section->second.find(name) != section->second.end();
+    }
+    if (!found)
+    {
+        // Structs are stored as section or only as parent of nested sections
+        std::string fullsection{ currentsection };
+        if (!fullsection.empty())
+        {
+            fullsection.append(".");
+        }
+        fullsection.append(name);
+        found = mStorage._contents.find(fullsection) != mStorage._contents.end();
+        if (!found)
+        {
+            fullsection.append(".");
+            const auto nested = mStorage._contents.lower_bound(fullsection);
+            found = nested != mStorage._contents.end() && nested->first.starts_with(fullsection);
+        }
+    }
+    ConfigLogic.resetCurrKey();
+    return found;
+}
+
 void ConfigFile_InputArchive::SkipBOM(std::ifstream &in)
 {
     char test[3] = { 0 };
@@ -466,12 +530,12 @@ auto ConfigFile_InputArchive::list(std::string value) -> typename ConfigFile::St
 {
     using type = decltype(mStorage.accessContents().cbegin()->second);
     type data;
-    ConfigLogic.setCurrKey(std::move(value));
+    ConfigLogic.setCurrKey(value);
     ConfigLogic.setCurrKey("Dummy");
 
-    if (mStorage.accessContents().find(ConfigLogic.getSection()) != mStorage.accessContents().end())
+    if (const auto it = mStorage.accessContents().find(ConfigLogic.getSection()); it != mStorage.accessContents().end())
     {
-        data = mStorage.accessContents().at(ConfigLogic.getSection());
+        data = it->second;
     }
     else
     {
@@ -485,7 +549,7 @@ auto ConfigFile_InputArchive::list(std::string value) -> typename ConfigFile::St
 
 auto ConfigFile_InputArchive::list(const Archives::NamedValue<decltype(nullptr)>& value) -> typename ConfigFile::Storage::keyvalues
 {
-    return list(value.getName());
+    return list(std::string{ value.getName() });
 }
 
 auto ConfigFile_InputArchive::list() -> typename ConfigFile::Storage::sections
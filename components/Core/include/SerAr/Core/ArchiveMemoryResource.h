@@ -0,0 +1,58 @@
+///---------------------------------------------------------------------------------------------------
+// file:		ArchiveMemoryResource.h
+//
+// summary: 	Declares the memory resource used for the internal state of the archives
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_ArchiveMemoryResource_H
+#define INC_ArchiveMemoryResource_H
+///---------------------------------------------------------------------------------------------------
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <memory_resource>
+#include <stack>
+#include <string>
+
+#include <MyCEL/basics/BasicMacros.h>
+
+namespace Archives
+{
+    // Containers for the transient state of the archives (group stacks, current names and paths)
+    template<typename T>
+    using pmr_stack = std::stack<T, std::pmr::deque<T>>;
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Memory resource for the transient state of an archive.
+    ///
+    /// 			If no resource is given in the options of the archive, an arena owned by the archive
+    /// 			is used: a pool (so names and groups pushed and popped for every field reuse their
+    /// 			memory) on top of a monotonic buffer starting with a small inline block. All of it is
+    /// 			released in one step when the archive is destroyed. A given resource is used directly
+    /// 			and must outlive the archive. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class ArchiveMemoryResource
+    {
+    public:
+        explicit ArchiveMemoryResource(std::pmr::memory_resource* resource = nullptr)
+            : mArena(mBuffer.data(), mBuffer.size(), std::pmr::get_default_resource()), mPool(&mArena),
+              mResource(resource != nullptr ? resource : &mPool) {}
+
+        DISALLOW_COPY_AND_ASSIGN(ArchiveMemoryResource)
+
+        inline std::pmr::memory_resource* get() const noexcept { return mResource; }
+    private:
+        alignas(std::max_align_t) std::array<std::byte, 1024> mBuffer;
+        std::pmr::monotonic_buffer_resource     mArena;
+        std::pmr::unsynchronized_pool_resource  mPool;
+        std::pmr::memory_resource*              mResource;
+    };
+}
+
+#endif	// INC_ArchiveMemoryResource_H
+// end of ArchiveMemoryResource.h
+///---------------------------------------------------------------------------------------------------
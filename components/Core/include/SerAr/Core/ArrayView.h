@@ -0,0 +1,130 @@
+///---------------------------------------------------------------------------------------------------
+// file:		ArrayView.h
+//
+// summary: 	Declares the support for saving from and loading into views of contiguous memory (std::span/std::mdspan)
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_ArrayView_H
+#define INC_ArrayView_H
+///---------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <version>
+#ifdef __cpp_lib_mdspan
+#include <mdspan>
+#endif
+
+#include <SerAr/Core/NamedValue.h>
+
+namespace Archives
+{
+    namespace traits
+    {
+        template<typename T>
+        struct is_span : std::false_type {};
+        template<typename T, std::size_t Extent>
+        struct is_span<std::span<T, Extent>> : std::true_type {};
+        template<typename T>
+        static constexpr bool is_span_v = is_span<std::remove_cvref_t<T>>::value;
+
+        template<typename T>
+        struct is_mdspan : std::false_type {};
+#ifdef __cpp_lib_mdspan
+        template<typename T, typename Extents, typename Layout, typename Accessor>
+        struct is_mdspan<std::mdspan<T, Extents, Layout, Accessor>> : std::true_type {};
+#endif
+        template<typename T>
+        static constexpr bool is_mdspan_v = is_mdspan<std::remove_cvref_t<T>>::value;
+    }
+}
+
+namespace SerAr
+{
+    // Views of contiguous memory with arithmetic elements: std::span and std::mdspan with std::layout_right
+    // (row-major) and the default accessor. Archives save directly from and load directly into the viewed memory.
+    template<typename T>
+    concept IsArrayView = (::Archives::traits::is_span_v<T> && std::is_arithmetic_v<typename std::remove_cvref_t<T>::element_type>)
+#ifdef __cpp_lib_mdspan
+        || (::Archives::traits::is_mdspan_v<T> && std::is_arithmetic_v<typename std::remove_cvref_t<T>::element_type>
+            && std::same_as<typename std::remove_cvref_t<T>::layout_type, std::layout_right>
+            && std::same_as<typename std::remove_cvref_t<T>::accessor_type, std::default_accessor<typename std::remove_cvref_t<T>::element_type>>)
+#endif
+        ;
+    template<typename T>
+    concept IsNamedArrayView = ::Archives::is_NamedValue_v<T> && IsArrayView<typename std::remove_cvref_t<T>::type>;
+}
+
+namespace Archives
+{
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Viewed elements in row-major order. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    template<SerAr::IsArrayView View>
+    inline auto arrayViewData(const View& view) noexcept
+    {
+        if constexpr (traits::is_span_v<View>)
+            return std::span<typename View::element_type>{ view.data(), view.size() };
+        else
+            return std::span<typename View::element_type>{ view.data_handle(), view.size() };
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Extents of the view (outermost first); a std::span has rank 1. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    template<SerAr::IsArrayView View>
+    inline auto arrayViewExtents(const View& view) noexcept
+    {
+        if constexpr (traits::is_span_v<View>) {
+            return std::array<std::size_t, 1>{ view.size() };
+        }
+        else {
+            std::array<std::size_t, View::rank()> extents{};
+            for (std::size_t dim = 0; dim < View::rank(); ++dim)
+                extents[dim] = static_cast<std::size_t>(view.extent(dim));
+            return extents;
+        }
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Throws if the dimensions stored in an archive do not fit the extents of the view
+    /// 			loaded into. Views of rank 1 accept every shape with the same number of elements;
+    /// 			otherwise trailing dimensions of 1 are ignored (MATLAB stores at least two). </summary>
+    ///-------------------------------------------------------------------------------------------------
+    inline void checkArrayViewExtents(std::string_view name, std::span<const std::size_t> stored, std::span<const std::size_t> extents)
+    {
+        const auto count = [](std::span<const std::size_t> dims) {
+            std::size_t elements{ 1 };
+            for (const auto dim : dims)
+                elements *= dim;
+            return elements;
+        };
+        const auto trim = [](std::span<const std::size_t> dims) {
+            while (!dims.empty() && dims.back() == 1)
+                dims = dims.first(dims.size() - 1);
+            return dims;
+        };
+        bool fits = count(stored) == count(extents);
+        if (fits && extents.size() > 1) {
+            const auto lhs = trim(stored);
+            const auto rhs = trim(extents);
+            fits = std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+        if (!fits)
+            throw std::runtime_error{ "Stored array '" + std::string{ name } + "' does not fit the extents of the view it is loaded into!" };
+    }
+}
+
+#endif	// INC_ArrayView_H
+// end of ArrayView.h
+///---------------------------------------------------------------------------------------------------
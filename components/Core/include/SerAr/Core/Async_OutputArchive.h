@@ -0,0 +1,239 @@
+///---------------------------------------------------------------------------------------------------
+// file:		Async_OutputArchive.h
+//
+// summary: 	Declares the asynchronous (write-behind) output archive class
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_Async_OutputArchive_H
+#define INC_Async_OutputArchive_H
+///---------------------------------------------------------------------------------------------------
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <MyCEL/basics/BasicMacros.h>
+#include <SerAr/Core/NamedValue.h>
+
+namespace Archives
+{
+    struct Async_OutputArchive_Options {
+        std::size_t max_queued_calls{ 64 }; // Calls to operator() waiting for the backend before the caller blocks; at least 1
+    };
+
+    namespace detail
+    {
+        // Owned copy of a value passed to Async_OutputArchive::operator()
+        template<typename T>
+        struct async_capture { using type = std::decay_t<T>; };
+        template<typename T>
+        struct async_capture<NamedValue<T>> { using type = NamedValue<std::remove_cvref_t<T>>; };
+        template<typename T>
+        using async_capture_t = typename async_capture<std::remove_cvref_t<T>>::type;
+
+        template<typename T>
+        inline async_capture_t<T> make_async_capture(T&& value)
+        {
+            using Type = std::remove_cvref_t<T>;
+            if constexpr (is_NamedValue_v<Type>) {
+                // The name is always copied; it might only be a view into memory of the caller.
+                constexpr bool move_value = !std::is_lvalue_reference_v<T> && !std::is_lvalue_reference_v<typename Type::type>;
+                if constexpr (move_value)
+                    return async_capture_t<T>{ NamedValueName{ std::string{ value.getName() } }, std::move(value.getValue()) };
+                else
+                    return async_capture_t<T>{ NamedValueName{ std::string{ value.getName() } }, std::remove_cvref_t<typename Type::type>{ value.getValue() } };
+            }
+            else {
+                return std::forward<T>(value);
+            }
+        }
+
+        template<typename Backend>
+        class AsyncJob
+        {
+        public:
+            virtual ~AsyncJob() = default;
+            virtual void write(Backend& ar) = 0;
+            // Called after write (or instead of it if the backend already failed)
+            virtual void finish(const std::exception_ptr&) noexcept {}
+        };
+
+        template<typename Backend, typename... Captured>
+        class AsyncWriteJob final : public AsyncJob<Backend>
+        {
+        public:
+            template<typename... Types>
+            explicit AsyncWriteJob(Types&&... args) : values(make_async_capture(std::forward<Types>(args))...) {}
+            void write(Backend& ar) override
+            {
+                std::apply([&ar](auto&... value) { ar(value...); }, values);
+            }
+        private:
+            std::tuple<Captured...> values;
+        };
+
+        template<typename Backend>
+        class AsyncFlushJob final : public AsyncJob<Backend>
+        {
+        public:
+            std::promise<void> done;
+            void write(Backend& ar) override
+            {
+                if constexpr (requires { ar.flush(); })
+                    ar.flush();
+            }
+            void finish(const std::exception_ptr& error) noexcept override
+            {
+                if (error)
+                    done.set_exception(error);
+                else
+                    done.set_value();
+            }
+        };
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Output archive doing the work of another output archive on a background thread.
+    ///
+    /// 			operator() copies (or moves if passed as rvalue) the given values and returns. A
+    /// 			dedicated thread passes them to the backend in the same order. If more than
+    /// 			max_queued_calls are waiting, operator() blocks until the backend caught up.
+    /// 			flush() returns a future which becomes ready once everything passed before has
+    /// 			been written to the backend and the backend has been flushed (if it has flush());
+    /// 			it holds the exception if the backend threw (also for flushes requested after the
+    /// 			failure; flush() itself does not throw it). After an exception all further values
+    /// 			are dropped and operator() rethrows it.
+    /// 			The backend itself is destroyed (and thus writes its file) with this archive.
+    /// 			Values holding references other than NamedValue (e.g. NamedValueWithDesc) are not
+    /// 			supported since they cannot be copied safely. </summary>
+    ///
+    /// <typeparam name="Backend"> Type of the output archive written to. </typeparam>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename Backend>
+    class Async_OutputArchive
+    {
+        using Job = detail::AsyncJob<Backend>;
+    public:
+        using Options = Async_OutputArchive_Options;
+
+        template<typename... Args>
+        explicit Async_OutputArchive(const Options& options, Args&&... args)
+            : mOptions(checkOptions(options)), mBackend(std::forward<Args>(args)...), mWorker([this] { run(); })
+        {}
+        ~Async_OutputArchive() noexcept
+        {
+            {
+                std::lock_guard lock{ mMutex };
+                mStop = true;
+            }
+            mNotEmpty.notify_one();
+            mWorker.join();
+        }
+
+        DISALLOW_COPY_AND_ASSIGN(Async_OutputArchive)
+
+        template <typename ... Types>
+        inline Async_OutputArchive& operator()(Types&& ... args)
+        {
+            using WriteJob = detail::AsyncWriteJob<Backend, detail::async_capture_t<Types>...>;
+            push(std::make_unique<WriteJob>(std::forward<Types>(args)...));
+            return *this;
+        }
+
+        std::future<void> flush()
+        {
+            auto flushJob = std::make_unique<detail::AsyncFlushJob<Backend>>();
+            auto future = flushJob->done.get_future();
+            std::unique_ptr<Job> job = std::move(flushJob);
+            if (const auto error = enqueue(job)) // The backend already failed; the future holds its exception
+                job->finish(error);
+            return future;
+        }
+    private:
+        const Options                       mOptions;
+        Backend                             mBackend;
+        std::mutex                          mMutex;
+        std::condition_variable             mNotEmpty;
+        std::condition_variable             mNotFull;
+        std::deque<std::unique_ptr<Job>>    mQueue;
+        std::exception_ptr                  mError{ nullptr };
+        bool                                mStop{ false };
+        std::thread                         mWorker; // Last member; the thread starts after everything else is constructed
+
+        static const Options& checkOptions(const Options& options)
+        {
+            if (options.max_queued_calls == 0)
+                throw std::runtime_error{ "An asynchronous archive needs to queue at least one call!" };
+            return options;
+        }
+
+        void push(std::unique_ptr<Job> job)
+        {
+            if (const auto error = enqueue(job))
+                std::rethrow_exception(error);
+        }
+
+        // Queues the job; if the backend already failed the job is left alone and the exception returned
+        std::exception_ptr enqueue(std::unique_ptr<Job>& job)
+        {
+            {
+                std::unique_lock lock{ mMutex };
+                mNotFull.wait(lock, [this] { return mQueue.size() < mOptions.max_queued_calls || mError; });
+                if (mError)
+                    return mError;
+                mQueue.push_back(std::move(job));
+            }
+            mNotEmpty.notify_one();
+            return nullptr;
+        }
+
+        void run()
+        {
+            for (;;) {
+                std::unique_ptr<Job> job;
+                std::exception_ptr error;
+                {
+                    std::unique_lock lock{ mMutex };
+                    mNotEmpty.wait(lock, [this] { return !mQueue.empty() || mStop; });
+                    if (mQueue.empty())
+                        return;
+                    job = std::move(mQueue.front());
+                    mQueue.pop_front();
+                    error = mError;
+                }
+                mNotFull.notify_one();
+
+                if (!error) {
+                    try {
+                        job->write(mBackend);
+                    }
+                    catch (...) {
+                        error = std::current_exception();
+                        std::lock_guard lock{ mMutex };
+                        mError = error;
+                    }
+                    if (error)
+                        mNotFull.notify_all(); // Wake up blocked callers to rethrow
+                }
+                job->finish(error);
+            }
+        }
+    };
+}
+
+#endif	// INC_Async_OutputArchive_H
+// end of Async_OutputArchive.h
+///---------------------------------------------------------------------------------------------------
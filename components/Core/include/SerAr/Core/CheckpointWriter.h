@@ -0,0 +1,301 @@
+///---------------------------------------------------------------------------------------------------
+// file:		CheckpointWriter.h
+//
+// summary: 	Declares the checkpoint writer class rotating between several archive files
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_CheckpointWriter_H
+#define INC_CheckpointWriter_H
+///---------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <MyCEL/basics/BasicMacros.h>
+#include <SerAr/Core/Async_OutputArchive.h>
+
+namespace Archives
+{
+    struct CheckpointWriter_Options {
+        std::size_t slots{ 2 }; // Number of files rotated through; at least 2 to always keep one complete checkpoint
+    };
+
+    namespace detail
+    {
+        // Entry of the manifest: a complete checkpoint
+        struct CheckpointEntry {
+            std::uint64_t   sequence;
+            std::string     file;   // Filename relative to the directory of the manifest
+        };
+
+        inline std::filesystem::path checkpointManifestPath(const std::filesystem::path& path)
+        {
+            auto manifest{ path };
+            manifest += ".manifest";
+            return manifest;
+        }
+
+        // Malformed lines are ignored; a missing manifest means no complete checkpoint exists.
+        inline std::vector<CheckpointEntry> readCheckpointManifest(const std::filesystem::path& manifest)
+        {
+            std::vector<CheckpointEntry> entries;
+            std::ifstream file{ manifest };
+            std::string line;
+            while (std::getline(file, line)) {
+                // The file name is the rest of the line after the separating space; it may contain spaces
+                std::istringstream linestream{ line };
+                CheckpointEntry entry{};
+                if (linestream >> entry.sequence && linestream.get() == ' ' && std::getline(linestream, entry.file) && !entry.file.empty())
+                    entries.push_back(std::move(entry));
+            }
+            std::sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) { return lhs.sequence > rhs.sequence; });
+            return entries;
+        }
+
+        // Forces the contents of the file to the disk; throws if that fails
+        inline void syncCheckpointFile(const std::filesystem::path& path)
+        {
+#if defined(_WIN32)
+            const int fd = ::_wopen(path.c_str(), _O_RDWR | _O_BINARY);
+            const bool synced = fd >= 0 && ::_commit(fd) == 0;
+            if (fd >= 0)
+                ::_close(fd);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            const bool synced = fd >= 0 && ::fsync(fd) == 0;
+            if (fd >= 0)
+                ::close(fd);
+#endif
+            if (!synced)
+                throw std::runtime_error{ "Unable to sync checkpoint file to disk: '" + path.string() + "'" };
+        }
+
+        // Makes a rename within the directory durable; otherwise a crash may bring back the old directory entry.
+        // Windows offers no such sync for directories (renames are journaled by NTFS).
+        inline void syncCheckpointDirectory([[maybe_unused]] const std::filesystem::path& path)
+        {
+#if !defined(_WIN32)
+            const auto directory = path.parent_path().empty() ? std::filesystem::path{ "." } : path.parent_path();
+            const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+            const bool synced = fd >= 0 && ::fsync(fd) == 0;
+            if (fd >= 0)
+                ::close(fd);
+            if (!synced)
+                throw std::runtime_error{ "Unable to sync checkpoint directory to disk: '" + directory.string() + "'" };
+#endif
+        }
+
+        // Written to a temporary file which then replaces the manifest, so readers always see a complete manifest.
+        inline void writeCheckpointManifest(const std::filesystem::path& manifest, const std::vector<CheckpointEntry>& entries)
+        {
+            auto tmp{ manifest };
+            tmp += ".tmp";
+            {
+                std::ofstream file{ tmp, std::ios::trunc };
+                for (const auto& entry : entries)
+                    file << entry.sequence << ' ' << entry.file << '\n';
+                file.flush();
+                if (!file)
+                    throw std::runtime_error{ "Unable to write checkpoint manifest: '" + tmp.string() + "'" };
+            }
+            syncCheckpointFile(tmp);
+            std::filesystem::rename(tmp, manifest);
+            syncCheckpointDirectory(manifest);
+        }
+
+        // The archives differ in the order of path and options in their constructors
+        template<typename Archive>
+        inline Archive openCheckpointArchive(const std::filesystem::path& path, const typename Archive::Options& options)
+        {
+            if constexpr (std::is_constructible_v<Archive, const std::filesystem::path&, const typename Archive::Options&>)
+                return Archive(path, options);
+            else
+                return Archive(options, path);
+        }
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Writes checkpoints rotating through a fixed number of archive files (slots).
+    ///
+    /// 			For the path "dir/run.h5" the slots are "dir/run.0.h5", "dir/run.1.h5", ... and the
+    /// 			manifest "dir/run.h5.manifest" lists the complete slots with their sequence number.
+    /// 			A checkpoint is written into the slot holding the oldest checkpoint: the slot is
+    /// 			removed from the manifest, the archive is written, flushed (if it has flush()),
+    /// 			closed and synced to disk, and only then the slot is added again with the next
+    /// 			sequence number. Replacing the manifest is done by renaming a temporary file, so
+    /// 			neither a crash nor a failed write ever loses the newest complete checkpoint.
+    /// 			Use restoreCheckpoint() to load the newest complete one.
+    /// 			write_async() does the same on a background thread; only one checkpoint is written
+    /// 			at a time. </summary>
+    ///
+    /// <typeparam name="Archive"> Output archive type; must be constructible from a path and its Options. </typeparam>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename Archive>
+    class CheckpointWriter
+    {
+    public:
+        using Options = CheckpointWriter_Options;
+        using ArchiveOptions = typename Archive::Options;
+
+        explicit CheckpointWriter(std::filesystem::path path, const ArchiveOptions& archive_options = ArchiveOptions{}, const Options& options = Options{})
+            : mOptions(options), mArchiveOptions(archive_options), mPath(std::move(path)),
+              mManifest(detail::checkpointManifestPath(mPath)), mEntries(detail::readCheckpointManifest(mManifest))
+        {
+            if (mOptions.slots < 2)
+                throw std::runtime_error{ "A checkpoint writer needs at least two slots!" };
+            if (!mEntries.empty())
+                mSequence = mEntries.front().sequence;
+        }
+        ~CheckpointWriter() noexcept
+        {
+            wait();
+        }
+
+        DISALLOW_COPY_AND_ASSIGN(CheckpointWriter)
+
+        // Writes a checkpoint containing the given values; returns its sequence number
+        template <typename ... Types>
+        std::uint64_t write(Types&& ... values)
+        {
+            wait();
+            return writeSlot(values...);
+        }
+
+        // Same as write() but on a background thread. The values are copied (or moved if passed as rvalue).
+        // The future holds the sequence number or the exception thrown while writing.
+        template <typename ... Types>
+        std::shared_future<std::uint64_t> write_async(Types&& ... values)
+        {
+            wait();
+            mPending = std::async(std::launch::async,
+                [this, captured = std::make_tuple(detail::make_async_capture(std::forward<Types>(values))...)]() mutable {
+                    return std::apply([this](auto&... value) { return writeSlot(value...); }, captured);
+                }).share();
+            return mPending;
+        }
+
+        // Waits for a checkpoint written by write_async()
+        void wait() const noexcept
+        {
+            if (mPending.valid())
+                mPending.wait();
+        }
+
+        std::filesystem::path slotPath(std::size_t slot) const
+        {
+            auto filename{ mPath.stem() };
+            filename += "." + std::to_string(slot);
+            filename += mPath.extension();
+            return mPath.parent_path() / filename;
+        }
+    private:
+        const Options                           mOptions;
+        const ArchiveOptions                    mArchiveOptions;
+        const std::filesystem::path             mPath;
+        const std::filesystem::path             mManifest;
+        std::vector<detail::CheckpointEntry>    mEntries;   // Newest first
+        std::uint64_t                           mSequence{ 0 };
+        std::shared_future<std::uint64_t>       mPending{};
+
+        // Slot without a complete checkpoint or else the one holding the oldest
+        std::size_t nextSlot() const
+        {
+            std::size_t next{ 0 };
+            std::optional<std::uint64_t> oldest{};
+            for (std::size_t slot = 0; slot < mOptions.slots; ++slot) {
+                const auto filename = slotPath(slot).filename().string();
+                const auto entry = std::find_if(mEntries.begin(), mEntries.end(), [&filename](const auto& e) { return e.file == filename; });
+                if (entry == mEntries.end())
+                    return slot;
+                if (!oldest || entry->sequence < *oldest) {
+                    oldest = entry->sequence;
+                    next = slot;
+                }
+            }
+            return next;
+        }
+
+        template <typename ... Types>
+        std::uint64_t writeSlot(Types& ... values)
+        {
+            const auto path = slotPath(nextSlot());
+            auto filename = path.filename().string();
+
+            // Mark the slot as incomplete before it is overwritten
+            std::erase_if(mEntries, [&filename](const auto& e) { return e.file == filename; });
+            detail::writeCheckpointManifest(mManifest, mEntries);
+            {
+                auto archive = detail::openCheckpointArchive<Archive>(path, mArchiveOptions);
+                archive(values...);
+                // Archive destructors swallow write errors; flushing explicitly lets them propagate
+                if constexpr (requires { archive.flush(); })
+                    archive.flush();
+            }   // The archive is closed here
+            detail::syncCheckpointFile(path); // Only now is the checkpoint complete
+
+            const auto sequence = mSequence + 1;
+            mEntries.insert(mEntries.begin(), detail::CheckpointEntry{ sequence, std::move(filename) });
+            detail::writeCheckpointManifest(mManifest, mEntries);
+            mSequence = sequence;
+            return sequence;
+        }
+    };
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Loads the newest complete checkpoint written by a CheckpointWriter. </summary>
+    ///
+    /// <typeparam name="Archive"> Input archive type; must be constructible from a path and its Options. </typeparam>
+    /// <param name="path">	   	Path given to the CheckpointWriter. </param>
+    /// <param name="options"> 	Options for the input archive. </param>
+    /// <param name="values">	Values to load (same as passed to CheckpointWriter::write). </param>
+    ///
+    /// <returns>	Sequence number of the loaded checkpoint; empty if none exists. If loading a checkpoint
+    /// 			fails the next older one is tried; if all fail the last exception is rethrown. </returns>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename Archive, typename ... Types>
+    std::optional<std::uint64_t> restoreCheckpoint(const std::filesystem::path& path, const typename Archive::Options& options, Types&& ... values)
+    {
+        std::exception_ptr error{ nullptr };
+        for (const auto& entry : detail::readCheckpointManifest(detail::checkpointManifestPath(path))) {
+            try {
+                auto archive = detail::openCheckpointArchive<Archive>(path.parent_path() / entry.file, options);
+                archive(std::forward<Types>(values)...);
+                return entry.sequence;
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+        return std::nullopt;
+    }
+}
+
+#endif	// INC_CheckpointWriter_H
+// end of CheckpointWriter.h
+///---------------------------------------------------------------------------------------------------
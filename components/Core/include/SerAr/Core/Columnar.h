@@ -0,0 +1,310 @@
+///---------------------------------------------------------------------------------------------------
+// file:		Columnar.h
+//
+// summary: 	Declares the columnar (struct of arrays) wrapper for containers of structs
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_Columnar_H
+#define INC_Columnar_H
+///---------------------------------------------------------------------------------------------------
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <MyCEL/basics/BasicMacros.h>
+#include <SerAr/Core/InputArchive.h>
+#include <SerAr/Core/NamedValue.h>
+#include <SerAr/Core/OutputArchive.h>
+
+namespace Archives
+{
+    namespace detail
+    {
+        template<typename Archive>
+        class ColumnBase
+        {
+        public:
+            virtual ~ColumnBase() = default;
+            // Saves or loads the column as NamedValue
+            virtual void process(Archive& ar, std::string_view name) = 0;
+            virtual std::size_t size() const = 0;
+        };
+
+        // One member of all elements
+        template<typename Archive, typename T>
+        class Column final : public ColumnBase<Archive>
+        {
+        public:
+            std::vector<T> values{};
+
+            void process(Archive& ar, std::string_view name) override { ar(createNamedValue(name, values)); }
+            std::size_t size() const override { return values.size(); }
+        };
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Columns of the members of a struct; nested structs are nested column sets (groups). </summary>
+        ///-------------------------------------------------------------------------------------------------
+        template<typename Archive>
+        class ColumnSet final : public ColumnBase<Archive>
+        {
+        public:
+            void process(Archive& ar, std::string_view name) override { ar(createNamedValue(name, *this)); }
+            // Length of the columns; throws if they differ
+            std::size_t size() const override
+            {
+                std::optional<std::size_t> count{};
+                checkSizes(count);
+                return count.value_or(0);
+            }
+
+            // Saves or loads all columns; the archive opens the group of this set before
+            void serialize(Archive& ar)
+            {
+                for (auto& [name, column] : mColumns)
+                    column->process(ar, name);
+            }
+
+            // Called before the members of the next element are visited
+            void rewind() noexcept { mCursor = 0; }
+
+            template<typename T>
+            std::vector<T>& column(std::string_view name)
+            {
+                auto column = dynamic_cast<Column<Archive, T>*>(&find<Column<Archive, T>>(name));
+                if (column == nullptr)
+                    throw std::runtime_error{ "Columnar: member '" + std::string{ name } + "' changed its type between elements!" };
+                return column->values;
+            }
+
+            ColumnSet& nested(std::string_view name)
+            {
+                auto set = dynamic_cast<ColumnSet*>(&find<ColumnSet>(name));
+                if (set == nullptr)
+                    throw std::runtime_error{ "Columnar: member '" + std::string{ name } + "' changed its type between elements!" };
+                set->rewind();
+                return *set;
+            }
+        private:
+            std::vector<std::pair<std::string, std::unique_ptr<ColumnBase<Archive>>>> mColumns{};
+            std::size_t mCursor{ 0 };
+
+            void checkSizes(std::optional<std::size_t>& count) const
+            {
+                for (const auto& [name, column] : mColumns) {
+                    if (const auto set = dynamic_cast<const ColumnSet*>(column.get())) {
+                        set->checkSizes(count);
+                    }
+                    else if (!count) {
+                        count = column->size();
+                    }
+                    else if (*count != column->size()) {
+                        throw std::runtime_error{ "Columnar: column '" + name + "' has a different length than the others!" };
+                    }
+                }
+            }
+
+            // Members are visited in the same order for every element; thus the cursor usually hits directly.
+            template<typename ColumnType>
+            ColumnBase<Archive>& find(std::string_view name)
+            {
+                if (mCursor < mColumns.size() && mColumns[mCursor].first == name)
+                    return *mColumns[mCursor++].second;
+                for (std::size_t i = 0; i < mColumns.size(); ++i) {
+                    if (mColumns[i].first == name) {
+                        mCursor = i + 1;
+                        return *mColumns[i].second;
+                    }
+                }
+                mColumns.emplace_back(std::string{ name }, std::make_unique<ColumnType>());
+                mCursor = mColumns.size();
+                return *mColumns.back().second;
+            }
+        };
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Creates the columns for the members of an element (layout pass) or appends the
+        /// 			members of the elements passed to it to the columns of a ColumnSet (gather pass). </summary>
+        ///-------------------------------------------------------------------------------------------------
+        template<typename Archive>
+        class ColumnGather_OutputArchive : public OutputArchive<ColumnGather_OutputArchive<Archive>>
+        {
+            using ThisClass = ColumnGather_OutputArchive<Archive>;
+            template<typename T>
+            static constexpr bool is_struct = IsTypeSaveable<std::remove_cvref_t<T>, ThisClass>;
+        public:
+            explicit ColumnGather_OutputArchive(ColumnSet<Archive>& columns) : OutputArchive<ThisClass>(this), mCurrent(&columns) {}
+
+            DISALLOW_COPY_AND_ASSIGN(ColumnGather_OutputArchive)
+
+            // Only creates the columns
+            void layout() noexcept { mLayout = true; }
+            void gather() noexcept { mLayout = false; }
+
+            template<typename T> requires (is_struct<T>)
+            inline void save(const NamedValue<T>& value)
+            {
+                auto parent = std::exchange(mCurrent, &mCurrent->nested(value.getName()));
+                this->operator()(value.getValue());
+                mCurrent = parent;
+            }
+
+            template<typename T> requires (!is_struct<T>)
+            inline void save(const NamedValue<T>& value)
+            {
+                auto& column = mCurrent->template column<std::remove_cvref_t<T>>(value.getName());
+                if (!mLayout)
+                    column.push_back(value.getValue());
+            }
+
+            template<typename T> requires (!is_struct<T> && !is_NamedValue_v<T>)
+            inline void save(const T&)
+            {
+                throw std::runtime_error{ "Columnar: all members must be named!" };
+            }
+        private:
+            ColumnSet<Archive>* mCurrent;
+            bool mLayout{ false };
+        };
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Creates the columns for the members of an element (layout pass) or assigns the
+        /// 			members of an element from the columns (scatter pass). </summary>
+        ///-------------------------------------------------------------------------------------------------
+        template<typename Archive>
+        class ColumnScatter_InputArchive : public InputArchive<ColumnScatter_InputArchive<Archive>>
+        {
+            using ThisClass = ColumnScatter_InputArchive<Archive>;
+            template<typename T>
+            static constexpr bool is_struct = IsTypeLoadable<std::remove_cvref_t<T>, ThisClass>;
+        public:
+            explicit ColumnScatter_InputArchive(ColumnSet<Archive>& columns) : InputArchive<ThisClass>(this), mCurrent(&columns) {}
+
+            DISALLOW_COPY_AND_ASSIGN(ColumnScatter_InputArchive)
+
+            // Only creates the columns
+            void layout() noexcept { mLayout = true; }
+            void scatter(std::size_t index) noexcept
+            {
+                mLayout = false;
+                mIndex = index;
+            }
+
+            template<typename T> requires (is_struct<T>)
+            inline void load(NamedValue<T>& value)
+            {
+                auto parent = std::exchange(mCurrent, &mCurrent->nested(value.getName()));
+                this->operator()(value.getValue());
+                mCurrent = parent;
+            }
+
+            template<typename T> requires (!is_struct<T>)
+            inline void load(NamedValue<T>& value)
+            {
+                auto& column = mCurrent->template column<std::remove_cvref_t<T>>(value.getName());
+                if (!mLayout)
+                    value.getValue() = std::move(column[mIndex]);
+            }
+
+            template<typename T> requires (!is_struct<T> && !is_NamedValue_v<T>)
+            inline void load(T&)
+            {
+                throw std::runtime_error{ "Columnar: all members must be named!" };
+            }
+        private:
+            ColumnSet<Archive>* mCurrent;
+            std::size_t mIndex{ 0 };
+            bool mLayout{ true };
+        };
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Stores a container of structs as one array per member (struct of arrays) instead of
+    /// 			one group/object per element: a std::vector<othertest> named "myvecnested" becomes
+    /// 			the arrays "myvecnested/mydouble", "myvecnested/myvector", ... Nested structs
+    /// 			become nested groups of arrays. Works with every archive able to store named
+    /// 			std::vectors of the member types and named structs (HDF5, MATLAB, JSON, ...).
+    /// 			The members are found by calling serialize/save/load of the element type, so all
+    /// 			of them must be NamedValues. The columns are laid out from a default constructed
+    /// 			element, so an empty container is written as empty arrays (if the elements are
+    /// 			not default constructible only its group). Loading needs default constructible
+    /// 			elements and a resizable container.
+    ///
+    /// 			Usage: ar(Archives::createNamedValue("myvecnested", Archives::createColumnar(vec))); </summary>
+    ///
+    /// <typeparam name="Container"> Type of the container of structs. </typeparam>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename Container>
+    class Columnar
+    {
+    public:
+        using container_type = std::remove_cvref_t<Container>;
+        using value_type = typename container_type::value_type;
+
+        explicit Columnar(Container& container) noexcept : mContainer(container) {}
+
+        template<typename Archive>
+        void save(Archive& ar) const
+        {
+            detail::ColumnSet<Archive> columns;
+            detail::ColumnGather_OutputArchive<Archive> gather{ columns };
+            if constexpr (std::is_default_constructible_v<value_type>) {
+                // Same layout as load(); also creates the columns of an empty container
+                const value_type prototype{};
+                gather.layout();
+                gather(prototype);
+                gather.gather();
+            }
+            for (const auto& element : mContainer) {
+                columns.rewind();
+                gather(element);
+            }
+            columns.serialize(ar);
+        }
+
+        template<typename Archive>
+        void load(Archive& ar)
+        {
+            static_assert(!std::is_const_v<Container>, "Cannot load into a const container!");
+            detail::ColumnSet<Archive> columns;
+            detail::ColumnScatter_InputArchive<Archive> scatter{ columns };
+            {
+                value_type prototype{};
+                scatter.layout();
+                scatter(prototype);
+            }
+            columns.serialize(ar);
+
+            const auto count = columns.size();
+            mContainer.clear();
+            mContainer.resize(count);
+            std::size_t index{ 0 };
+            for (auto& element : mContainer) {
+                columns.rewind();
+                scatter.scatter(index++);
+                scatter(element);
+            }
+        }
+    private:
+        Container& mContainer;
+    };
+
+    template<typename Container>
+    inline Columnar<Container> createColumnar(Container& container)
+    {
+        return Columnar<Container>{ container };
+    }
+}
+
+#endif	// INC_Columnar_H
+// end of Columnar.h
+///---------------------------------------------------------------------------------------------------
@@ -0,0 +1,97 @@
+///---------------------------------------------------------------------------------------------------
+// file:		Deferred.h
+//
+// summary: 	Declares the deferred (lazy loaded) value class
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_Deferred_H
+#define INC_Deferred_H
+///---------------------------------------------------------------------------------------------------
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace Archives
+{
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Value which is only read from an input archive on first access.
+    ///
+    /// 			Input archives supporting it (HDF5, JSON, MATLAB) only record the location of a
+    /// 			NamedValue holding a Deferred (HDF5 dataset path, JSON pointer, MATLAB field path)
+    /// 			instead of loading it. get() loads the value on first use. The archive must still be
+    /// 			alive (and not moved) at that point. To save it pass get() to the output archive. </summary>
+    ///
+    /// <typeparam name="T"> Type of the value; must be default constructible. </typeparam>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename T>
+    class Deferred
+    {
+        static_assert(std::is_default_constructible_v<T>, "Deferred requires a default constructible type!");
+    public:
+        using value_type = T;
+        using loader_type = std::function<void(std::string_view location, T& value)>;
+
+        Deferred() = default;
+        explicit Deferred(T value) : mValue(std::move(value)) {}
+
+        // Called by the input archives
+        void setLoader(std::string location, loader_type loader)
+        {
+            mValue.reset();
+            mLocation = std::move(location);
+            mLoader = std::move(loader);
+        }
+
+        bool isLoaded() const noexcept { return mValue.has_value(); }
+        std::string_view getLocation() const noexcept { return mLocation; }
+
+        T& get()
+        {
+            if (!mValue)
+                load();
+            return *mValue;
+        }
+        const T& get() const
+        {
+            if (!mValue)
+                load();
+            return *mValue;
+        }
+        T& operator*() { return get(); }
+        const T& operator*() const { return get(); }
+        T* operator->() { return &get(); }
+        const T* operator->() const { return &get(); }
+    private:
+        mutable std::optional<T>    mValue{};
+        std::string                 mLocation{};
+        loader_type                 mLoader{};
+
+        void load() const
+        {
+            if (!mLoader)
+                throw std::runtime_error{ "Deferred value was never assigned a location to load from!" };
+            T value{};
+            mLoader(mLocation, value);
+            mValue = std::move(value);
+        }
+    };
+
+    template<typename T>
+    struct is_Deferred : std::false_type {};
+    template<typename T>
+    struct is_Deferred<Deferred<T>> : std::true_type {};
+    template<typename T>
+    static constexpr bool is_Deferred_v = is_Deferred<std::remove_cvref_t<T>>::value;
+}
+
+#endif	// INC_Deferred_H
+// end of Deferred.h
+///---------------------------------------------------------------------------------------------------
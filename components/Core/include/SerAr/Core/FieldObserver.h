@@ -0,0 +1,199 @@
+///---------------------------------------------------------------------------------------------------
+// file:		FieldObserver.h
+//
+// summary: 	Declares the per field instrumentation hooks of the archive dispatch
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_FieldObserver_H
+#define INC_FieldObserver_H
+///---------------------------------------------------------------------------------------------------
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// The observer hooks are only compiled into OutputArchive/InputArchive if SERAR_HAS_FIELD_OBSERVER
+// is defined (CMake option SERAR_WITH_FIELDOBSERVER). Without it the dispatch is unchanged and
+// nothing in here is used. The define changes the layout of the archives so it has to be the same
+// for every translation unit (it is set as an interface definition of the Core target).
+
+namespace SerAr
+{
+    enum class FieldDirection { Save, Load };
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Information about a single field passed through an archive. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    struct FieldEvent
+    {
+        FieldDirection              direction;
+        std::string_view            path;       // Names of all enclosing named values joined by '.'
+        std::string_view            name;       // Name of the field; empty for unnamed values (e.g. container elements)
+        std::string_view            type;       // C++ type of the (unwrapped) value
+        std::chrono::nanoseconds    elapsed;    // Time spent in prologue, save/load and epilogue including all nested fields
+        std::size_t                 bytes;      // Bytes produced/consumed including all nested fields
+        std::size_t                 depth;      // Number of enclosing named values (0 for top level values)
+    };
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Interface for field observers. Install with archive.setFieldObserver(&observer).
+    /// 			onField is called after a field has been completely saved or loaded, so nested
+    /// 			fields are reported before their parent.  </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class IFieldObserver
+    {
+    public:
+        virtual ~IFieldObserver() = default;
+        virtual void onField(const FieldEvent& event) = 0;
+    };
+
+    // Archives can report the real amount of bytes they produced/consumed so far. If they don't,
+    // the payload size of arithmetic values, strings and contiguous ranges is used instead.
+    template<typename Archive>
+    concept HasBytesWritten = requires (const Archive& ar) { { ar.bytesWritten() } -> std::convertible_to<std::size_t>; };
+    template<typename Archive>
+    concept HasBytesRead = requires (const Archive& ar) { { ar.bytesRead() } -> std::convertible_to<std::size_t>; };
+
+    namespace detail
+    {
+        template<typename T>
+        constexpr std::string_view type_name() noexcept
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            constexpr std::string_view func{ __FUNCSIG__ };
+            constexpr auto first = func.find("type_name<") + 10;
+            constexpr auto last = func.rfind(">(void)");
+#else
+            // GCC: "... type_name() [with T = int; std::string_view = ...]" Clang: "... type_name() [T = int]"
+            constexpr std::string_view func{ __PRETTY_FUNCTION__ };
+            constexpr auto first = func.find("T = ") + 4;
+            constexpr auto semicolon = func.find("; ", first);
+            constexpr auto last = semicolon != std::string_view::npos ? semicolon : func.rfind(']');
+#endif
+            return func.substr(first, last - first);
+        }
+
+        template<typename T>
+        constexpr std::string_view field_name(const T& value) noexcept
+        {
+            if constexpr (requires { { value.getName() } -> std::convertible_to<std::string_view>; })
+                return value.getName();
+            else if constexpr (requires { value.val; { value.name } -> std::convertible_to<std::string_view>; })
+                return value.name;
+            else
+                return {};
+        }
+
+        template<typename T>
+        constexpr decltype(auto) field_value(const T& value) noexcept
+        {
+            if constexpr (requires { value.getValue(); value.getName(); })
+                return value.getValue();
+            else if constexpr (requires { value.val; value.name; })
+                return (value.val);
+            else
+                return (value);
+        }
+
+        template<typename T>
+        concept ArithmeticSizedContainer = requires (const T& value) { typename T::value_type; value.size(); }
+            && (std::is_arithmetic_v<typename T::value_type> || std::is_enum_v<typename T::value_type>);
+
+        template<typename T>
+        std::size_t payload_bytes(const T& value) noexcept
+        {
+            using Type = std::remove_cvref_t<T>;
+            if constexpr (std::is_arithmetic_v<Type> || std::is_enum_v<Type>)
+                return sizeof(Type);
+            else if constexpr (ArithmeticSizedContainer<Type>)
+                return static_cast<std::size_t>(value.size()) * sizeof(typename Type::value_type);
+            else if constexpr (std::ranges::range<const Type>) {
+                std::size_t bytes{ 0 };
+                for (const auto& element : value)
+                    bytes += payload_bytes(element);
+                return bytes;
+            }
+            else
+                return 0;
+        }
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	State kept by an archive with an installed observer. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class FieldObserverState
+    {
+    public:
+        IFieldObserver*     observer{ nullptr };
+        std::string         path{};         // Current field path; the buffer is reused between fields
+        std::size_t         depth{ 0 };     // Named fields currently open
+        std::size_t         bytes{ 0 };     // Estimated bytes of all reported fields; used if the archive has no counter
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Scope of one observed field. Restores the path if the field throws. </summary>
+        ///-------------------------------------------------------------------------------------------------
+        class Scope
+        {
+        public:
+            Scope(FieldObserverState& state, std::string_view name, std::size_t archive_bytes)
+                : mState(state), mPathSize(state.path.size()), mBytes(archive_bytes), mEstimate(state.bytes), mName(name),
+                  mStart(std::chrono::steady_clock::now())
+            {
+                if (!name.empty()) {
+                    if (!mState.path.empty())
+                        mState.path.push_back('.');
+                    mState.path.append(name);
+                    ++mState.depth;
+                }
+            }
+            ~Scope() noexcept
+            {
+                if (!mName.empty())
+                    --mState.depth;
+                mState.path.resize(mPathSize);
+            }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            // Reports the field. archive_bytes is the counter of the archive (if available) after the field.
+            template<bool ArchiveCounts, typename T>
+            void finish(FieldDirection direction, const T& value, std::size_t archive_bytes)
+            {
+                const auto elapsed = std::chrono::steady_clock::now() - mStart;
+                std::size_t bytes = archive_bytes - mBytes;
+                if constexpr (!ArchiveCounts) {
+                    // Nested fields already have been counted. Only estimate leafs to not count twice.
+                    bytes = mState.bytes - mEstimate;
+                    if (bytes == 0) {
+                        bytes = detail::payload_bytes(detail::field_value(value));
+                        mState.bytes += bytes;
+                    }
+                }
+                using ValueType = std::remove_cvref_t<decltype(detail::field_value(value))>;
+                const FieldEvent event{ direction, mState.path, mName, detail::type_name<ValueType>(),
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed), bytes, mState.depth - (mName.empty() ? 0 : 1) };
+                mState.observer->onField(event);
+            }
+        private:
+            FieldObserverState&                     mState;
+            const std::size_t                       mPathSize;
+            const std::size_t                       mBytes;
+            const std::size_t                       mEstimate;
+            const std::string_view                  mName;
+            const std::chrono::steady_clock::time_point mStart;
+        };
+    };
+}
+
+#endif	// INC_FieldObserver_H
+// end of FieldObserver.h
+///---------------------------------------------------------------------------------------------------
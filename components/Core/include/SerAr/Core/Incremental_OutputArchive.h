@@ -0,0 +1,279 @@
+///---------------------------------------------------------------------------------------------------
+// file:		Incremental_OutputArchive.h
+//
+// summary: 	Declares the incremental (dirty tracking) output archive class
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_Incremental_OutputArchive_H
+#define INC_Incremental_OutputArchive_H
+///---------------------------------------------------------------------------------------------------
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <SerAr/Core/NamedValue.h>
+#include <SerAr/Core/OutputArchive.h>
+#include <SerAr/Core/Tee_OutputArchive.h>
+
+namespace Archives
+{
+    // Content hash of every field written by an Incremental_OutputArchive; key is the path of the field (names joined by '/')
+    using FieldHashes = std::unordered_map<std::string, std::uint64_t>;
+
+    namespace detail
+    {
+        template<typename T>
+        concept ContentHashScalar = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::same_as<T, std::complex<float>>
+                                    || std::same_as<T, std::complex<double>> || std::same_as<T, std::complex<long double>>;
+        template<typename T>
+        concept ContentHashString = std::same_as<T, std::string> || std::same_as<T, std::string_view>;
+        // std::vector, std::array, Eigen::Matrix, ...
+        template<typename T>
+        concept ContentHashContiguous = !ContentHashString<T> && requires(const T& value) {
+            typename T::value_type;
+            { value.data() } -> std::convertible_to<const typename T::value_type*>;
+            { value.size() } -> std::convertible_to<std::size_t>;
+        } && ContentHashScalar<typename T::value_type>;
+        template<typename T>
+        concept ContentHashLeaf = ContentHashScalar<T> || ContentHashString<T> || ContentHashContiguous<T>;
+        template<typename T>
+        concept ContentHashRange = !ContentHashLeaf<T> && std::ranges::range<const T>;
+        template<typename T>
+        concept ContentHashTupleLike = !ContentHashLeaf<T> && !ContentHashRange<T> && requires { std::tuple_size<T>::value; };
+
+        // Bytes of a scalar holding its value. The x87 80 bit long double only uses the first 10 of its 12 or 16 bytes;
+        // the padding is indeterminate and would make equal values hash differently.
+        template<typename T>
+        inline constexpr std::size_t ContentHashValueBytes = sizeof(T);
+        template<>
+        inline constexpr std::size_t ContentHashValueBytes<long double> = std::numeric_limits<long double>::digits == 64 && sizeof(long double) > 10 ? 10 : sizeof(long double);
+        template<> // 0: hashed part by part
+        inline constexpr std::size_t ContentHashValueBytes<std::complex<long double>> = ContentHashValueBytes<long double> == sizeof(long double)
+                                                                                        ? sizeof(std::complex<long double>) : 0;
+
+        // 64 bit FNV-1a working on 8 byte words (with an extra shift for mixing) so that large arrays are cheap to hash.
+        // Only meant to detect changes; it is not a cryptographic hash.
+        class ContentHasher
+        {
+            static constexpr std::uint64_t prime{ 1099511628211ull };
+            std::uint64_t mHash{ 14695981039346656037ull };
+        public:
+            inline void add(const void* data, std::size_t size) noexcept
+            {
+                auto bytes = static_cast<const unsigned char*>(data);
+                for (; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t), bytes += sizeof(std::uint64_t)) {
+                    std::uint64_t word;
+                    std::memcpy(&word, bytes, sizeof(word));
+                    mHash = (mHash ^ word) * prime;
+                    mHash ^= mHash >> 29;
+                }
+                for (; size > 0; --size, ++bytes)
+                    mHash = (mHash ^ *bytes) * prime;
+            }
+            inline void add(std::size_t size) noexcept { add(&size, sizeof(size)); }
+            template<typename T> requires (ContentHashScalar<T>)
+            inline void addScalar(const T& value) noexcept
+            {
+                if constexpr (ContentHashValueBytes<T> != 0) {
+                    add(&value, ContentHashValueBytes<T>);
+                }
+                else { // Complex numbers with padding in their parts
+                    const auto real = value.real();
+                    const auto imag = value.imag();
+                    addScalar(real);
+                    addScalar(imag);
+                }
+            }
+            inline void add(std::string_view str) noexcept
+            {
+                add(str.size());
+                add(str.data(), str.size());
+            }
+            inline std::uint64_t get() const noexcept { return mHash; }
+        };
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Output archive which only hashes the content (names and values) of everything passed
+    /// 			to it. User types are walked through their serialize()/save() functions. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class ContentHash_OutputArchive : public OutputArchive<ContentHash_OutputArchive>
+    {
+    public:
+        ContentHash_OutputArchive() : OutputArchive(this) {}
+
+        DISALLOW_COPY_AND_ASSIGN(ContentHash_OutputArchive)
+
+        template<typename T>
+        inline void save(const NamedValue<T>& value)
+        {
+            mHasher.add(std::string_view{ value.getName() });
+            this->operator()(value.getValue());
+        }
+
+        template<typename T> requires (detail::ContentHashLeaf<T>)
+        inline void save(const T& value)
+        {
+            if constexpr (detail::ContentHashScalar<T>) {
+                mHasher.addScalar(value);
+            }
+            else if constexpr (detail::ContentHashString<T>) {
+                mHasher.add(std::string_view{ value });
+            }
+            else {
+                const auto size = static_cast<std::size_t>(value.size());
+                mHasher.add(size);
+                if constexpr (requires { value.rows(); })
+                    mHasher.add(static_cast<std::size_t>(value.rows()));
+                using Scalar = typename T::value_type;
+                if constexpr (detail::ContentHashValueBytes<Scalar> == sizeof(Scalar)) {
+                    mHasher.add(value.data(), size * sizeof(Scalar));
+                }
+                else {
+                    for (std::size_t i = 0; i < size; ++i)
+                        mHasher.addScalar(value.data()[i]);
+                }
+            }
+        }
+
+        template<typename T> requires (detail::ContentHashRange<T>)
+        inline void save(const T& values)
+        {
+            mHasher.add(static_cast<std::size_t>(std::ranges::distance(values)));
+            for (const auto& element : values)
+                this->operator()(element);
+        }
+
+        template<typename T> requires (detail::ContentHashTupleLike<T>)
+        inline void save(const T& values)
+        {
+            std::apply([this](const auto&... element) { (this->operator()(element), ...); }, values);
+        }
+
+        inline std::uint64_t getHash() const noexcept { return mHasher.get(); }
+    private:
+        detail::ContentHasher mHasher{};
+    };
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Output archive only passing fields to another output archive if their content changed
+    /// 			since the last time they were written through this archive.
+    ///
+    /// 			Named user types are traversed by this archive itself (groups are opened in the
+    /// 			backend via the SerAr::HasGroupInterface). Every other named value is hashed with a
+    /// 			ContentHash_OutputArchive and only written to the backend if the hash of its path
+    /// 			differs from the stored one. Unnamed values are always written.
+    /// 			The backend must keep skipped fields from the previous save: HDF5 keeps them in the
+    /// 			file, JSON and ConfigFile in their in memory tree (call flush() to write a checkpoint).
+    /// 			MATLAB rewrites whole top level variables and is therefore not suitable.
+    /// 			The hashes can be taken over from a previous archive (getHashes()) to continue writing
+    /// 			into the same file with a new backend. The backend is not owned and must outlive this archive. </summary>
+    ///
+    /// <typeparam name="Backend"> Type of the output archive written to. </typeparam>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename Backend>
+    class Incremental_OutputArchive : public OutputArchive<Incremental_OutputArchive<Backend>>
+    {
+        static_assert(IsOutputArchive<Backend>, "The backend of an Incremental_OutputArchive must be an output archive!");
+        static_assert(HasGroupInterface<Backend>, "The backend of an Incremental_OutputArchive must implement beginGroup/endGroup!");
+
+        using ThisClass = Incremental_OutputArchive<Backend>;
+
+        template<typename T>
+        static constexpr bool traverse = IsTypeSaveable<std::remove_cvref_t<T>, ThisClass>;
+    public:
+        explicit Incremental_OutputArchive(Backend& backend, FieldHashes previous = FieldHashes{})
+            : OutputArchive<ThisClass>(this), mBackend(backend), mHashes(std::move(previous)) {}
+
+        DISALLOW_COPY_AND_ASSIGN(Incremental_OutputArchive)
+
+        // Named user types: traversed by this archive
+        template<typename T> requires (traverse<T>)
+        inline void save(const NamedValue<T>& value)
+        {
+            const std::string_view name{ value.getName() };
+            const auto length = enter(name);
+            mBackend.beginGroup(name);
+            this->operator()(value.getValue());
+            mBackend.endGroup();
+            mPath.resize(length);
+        }
+
+        // Everything else which is named: only written if the content changed
+        template<typename T> requires (!traverse<T>)
+        inline void save(const NamedValue<T>& value)
+        {
+            const auto length = enter(value.getName());
+            ContentHash_OutputArchive hasher{};
+            hasher(value.getValue());
+            const auto hash = hasher.getHash();
+            if (const auto it = mHashes.find(mPath); it != mHashes.end() && it->second == hash) {
+                ++mSkipped;
+            }
+            else {
+                mBackend(value);
+                if (it != mHashes.end())
+                    it->second = hash;
+                else
+                    mHashes.emplace(mPath, hash);
+                ++mWritten;
+            }
+            mPath.resize(length);
+        }
+
+        // Unnamed values cannot be tracked
+        template<typename T> requires (!traverse<T> && !is_NamedValue_v<T>)
+        inline void save(const T& value)
+        {
+            mBackend(value);
+            ++mWritten;
+        }
+
+        // Writes everything to disk if the backend supports it
+        inline void flush()
+        {
+            if constexpr (requires { mBackend.flush(); })
+                mBackend.flush();
+        }
+
+        // Forces all fields to be written on the next save
+        inline void markAllDirty() noexcept { mHashes.clear(); }
+
+        inline const FieldHashes& getHashes() const noexcept { return mHashes; }
+        inline std::size_t writtenFields() const noexcept { return mWritten; }
+        inline std::size_t skippedFields() const noexcept { return mSkipped; }
+        inline Backend& getBackend() noexcept { return mBackend; }
+    private:
+        Backend&        mBackend;
+        FieldHashes     mHashes;
+        std::string     mPath{};
+        std::size_t     mWritten{ 0 };
+        std::size_t     mSkipped{ 0 };
+
+        // Appends name to the current path; returns the length to restore afterwards
+        inline std::size_t enter(std::string_view name)
+        {
+            const auto length = mPath.size();
+            mPath.append("/").append(name);
+            return length;
+        }
+    };
+}
+
+#endif	// INC_Incremental_OutputArchive_H
+// end of Incremental_OutputArchive.h
+///---------------------------------------------------------------------------------------------------
@@ -18,8 +18,17 @@
 #pragma warning( disable : 4814) // constexpr is not implicit const Warning
 #endif
 
+#include <cstddef>
+#include <memory>
+#include <new>
+
 #include <MyCEL/basics/BasicMacros.h>
 #include <SerAr/Core/ArchiveHelper.h>
+#include <SerAr/Core/NamedValueWithDefault.h>
+#include <SerAr/Core/ObjectTracker.h>
+#ifdef SERAR_HAS_FIELD_OBSERVER
+#include <SerAr/Core/FieldObserver.h>
+#endif
 
 namespace Archives
 {
@@ -38,6 +47,8 @@ namespace Archives
     };
 
     class ISerializeable; //Forward declaration
+    template<typename ToConstruct>
+    class LoadConstructor; //Forward declaration; defined in LoadConstructor.h (included at the end)
 
     class IInputArchive
     {
@@ -63,16 +74,116 @@ namespace Archives
         }
 
         // Serializes data
-        template <typename T>
+        template <typename T> requires (!UseSharedObjectLoad<T, ArchiveType> && !IsDefaultableField<T>)
         inline void work(T&& head)
         {
             static_assert(!std::is_const_v<T>, "Cannot load into a const value T!");
             //static_assert(!std::is_lvalue_reference<T>::value, "Passed rvalue reference for loading from Input Archive! \n (Impossible since load can not write a value into a temporary)");
+#ifdef SERAR_HAS_FIELD_OBSERVER
+            if (mFieldObserver.observer) {
+                FieldObserverState::Scope field{ mFieldObserver, ::SerAr::detail::field_name(head), readBytes() };
+                self().beforework(head);
+                self().dowork(head);
+                self().afterwork(head);
+                field.template finish<HasBytesRead<ArchiveType>>(FieldDirection::Load, head, readBytes());
+                return;
+            }
+#endif
             self().beforework(head);
             self().dowork(head);
             self().afterwork(head);
         }
 
+        // std::shared_ptr: objects stored once and referenced elsewhere are created once and shared again
+        template <typename T> requires (UseSharedObjectLoad<T, ArchiveType>)
+        inline void work(T&& head)
+        {
+            std::string_view name{};
+            if constexpr (is_NamedValue_v<T>)
+                name = head.getName();
+            auto& pointer = [&]() -> decltype(auto) {
+                if constexpr (is_NamedValue_v<T>)
+                    return head.getValue();
+                else
+                    return head;
+            }();
+            using Pointer = std::remove_cvref_t<decltype(pointer)>;
+            using Object = std::remove_cv_t<typename Pointer::element_type>;
+
+            auto& tracker = self().objectTracker();
+            auto identity = std::string{ self().objectIdentity(name) };
+            if (auto object = tracker.template findLoaded<Object>(identity)) {
+                pointer = std::move(object);
+                return;
+            }
+            // Loaded unnamed at the stored object if the archive can move there (see SerAr::HasSharedObjectScope)
+            constexpr bool named = is_NamedValue_v<T> && !HasSharedObjectScope<ArchiveType>;
+            [[maybe_unused]] const auto scope = [&]() {
+                if constexpr (HasSharedObjectScope<ArchiveType>)
+                    return self().objectScope(identity);
+                else
+                    return 0;
+            }();
+            if constexpr (LoadConstructor<Object>::template is_default_loaded_v<ArchiveType>) {
+                auto object = std::make_shared<Object>();
+                tracker.addLoaded(identity, object); // Before the object is loaded so that cycles end here
+                if constexpr (named)
+                    work(createNamedValue(name, *object));
+                else
+                    work(*object);
+                pointer = std::move(object);
+            }
+            else {
+                // Constructed by LoadConstructor in place. The storage is registered before so that cycles end
+                // here; references to the object may be kept but not used while it is constructed.
+                struct Storage {
+                    alignas(Object) std::byte bytes[sizeof(Object)];
+                    bool constructed{ false };
+                    ~Storage() { if (constructed) std::destroy_at(std::launder(reinterpret_cast<Object*>(bytes))); }
+                };
+                auto storage = std::make_shared<Storage>();
+                auto object = std::shared_ptr<Object>(storage, reinterpret_cast<Object*>(storage->bytes));
+                tracker.addLoaded(identity, object);
+                try {
+                    if constexpr (named)
+                        LoadConstructor<Object>::construct_at(object.get(), self(), name);
+                    else
+                        LoadConstructor<Object>::construct_at(object.get(), self());
+                }
+                catch (...) {
+                    tracker.eraseLoaded(identity);
+                    throw;
+                }
+                storage->constructed = true;
+                pointer = std::move(object);
+            }
+        }
+
+        // Fields which may be missing: std::optional is reset and NamedValueWithDefault is set to its default.
+        // Archives without a lookup (SerAr::HasFieldLookup) load them like a NamedValue.
+        template <typename T> requires (IsDefaultableField<T>)
+        inline void work(T&& head)
+        {
+            if constexpr (HasFieldLookup<ArchiveType>) {
+                if (!self().contains(head.getName())) {
+                    if constexpr (IsOptionalNamedValue<T>)
+                        head.getValue().reset();
+                    else
+                        head.getValue() = head.getDefault();
+                    return;
+                }
+            }
+            if constexpr (IsOptionalNamedValue<T>) {
+                auto& optional = head.getValue();
+                if (!optional)
+                    optional.emplace();
+                work(createNamedValue(head.getName(), *optional));
+            }
+            else {
+                work(createNamedValue(head.getName(), head.getValue()));
+            }
+        }
+
         // Recursion to unwind parameter list (has to be an overload for ADL lookup)
         template <typename T, typename ... Other>
         inline void work(T&& head, Other&& ... tail)
@@ -157,6 +268,18 @@ namespace Archives
             return self();
         }
 
+#ifdef SERAR_HAS_FIELD_OBSERVER
+        FieldObserverState mFieldObserver{};
+
+        inline std::size_t readBytes() const noexcept
+        {
+            if constexpr (HasBytesRead<ArchiveType>)
+                return static_cast<std::size_t>(static_cast<const ArchiveType&>(*this).bytesRead());
+            else
+                return 0;
+        }
+#endif
+
     protected:
         constexpr InputArchive(ArchiveType* const) noexcept {}
         DISALLOW_COPY_AND_ASSIGN(InputArchive)
@@ -169,6 +292,15 @@ namespace Archives
             self().work(std::forward<Types>(args)...);
             return self();
         }
+#ifdef SERAR_HAS_FIELD_OBSERVER
+        // Installs an observer which gets called for every loaded field. Pass nullptr to remove it.
+        // The observer is not owned and must outlive the archive or be removed before.
+        inline IFieldObserver* setFieldObserver(IFieldObserver* observer) noexcept
+        {
+            return std::exchange(mFieldObserver.observer, observer);
+        }
+        inline IFieldObserver* getFieldObserver() const noexcept { return mFieldObserver.observer; }
+#endif
     };
 
 }
@@ -177,6 +309,8 @@ namespace Archives
 #pragma warning(pop)
 #endif
 
+#include <SerAr/Core/LoadConstructor.h> // Needs the complete InputArchive
+
 #endif	// INC_InputArchive_H
 // end of InputArchive.h
 ///---------------------------------------------------------------------------------------------------
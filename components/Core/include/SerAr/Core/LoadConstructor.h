@@ -13,15 +13,69 @@
 ///---------------------------------------------------------------------------------------------------
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
 #include <SerAr/Core/InputArchive.h>
 #include <SerAr/Core/NamedValue.h>
 
 namespace Archives
 {
+    /// <summary>	Tag selecting the load constructor T(load_construct_t, Archive&) of a type. </summary>
+    struct load_construct_t { explicit load_construct_t() = default; };
+    inline constexpr load_construct_t load_construct{};
+
+    namespace traits
+    {
+        // T(Archives::load_construct, ar): builds the object directly from the archive
+        template<typename T, typename Archive>
+        concept HasLoadConstructor = std::is_constructible_v<T, load_construct_t, Archive&>;
+        // static T T::load_construct(ar): factory returning the loaded object
+        template<typename T, typename Archive>
+        concept HasLoadFactory = requires(Archive & ar) {
+            { T::load_construct(ar) } -> std::same_as<T>;
+        };
+    }
+
+    template<typename ToConstruct>
+    class LoadConstructor;
+
+    namespace detail
+    {
+        // Forwards loading of a NamedValue to LoadConstructor<T>::construct_at so the archive selects
+        // the named location (group, JSON object, ...) before the object is constructed.
+        template<typename T>
+        struct LoadConstructProxy
+        {
+            T* storage;
+            bool constructed{ false };
+
+            template<typename Archive>
+            void serialize(Archive& ar)
+            {
+                LoadConstructor<T>::construct_at(storage, ar);
+                constructed = true;
+            }
+        };
+    }
+
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	A load constructor interface for archives.
-    /// 			Common helper class to construct not default constructable objects
-    /// 			Use a specialization of this class for not default constructable objects. </summary>
+    /// 			Common helper class to construct objects from an archive. Types are constructed by
+    /// 			(in this order):
+    /// 			- a load constructor T(Archives::load_construct_t, Archive&),
+    /// 			- a static factory T T::load_construct(Archive&) or
+    /// 			- default construction followed by loading into the object.
+    /// 			construct_at builds directly into given storage (no temporary); emplace_into appends
+    /// 			to containers the same way (e.g. vec.emplace_back(Archives::load_construct, ar)).
+    /// 			Use a specialization of this class for types which cannot provide any of the above. </summary>
     ///
     /// <typeparam name="ToConstruct">	Type to construct. </typeparam>
     ///-------------------------------------------------------------------------------------------------
@@ -31,30 +85,144 @@ namespace Archives
     public:
         using type = ToConstruct;
 
-        static_assert(std::is_constructible<type, void>::value, "Type is not constructable without arguments. Archives need specialization of LoadConstructor ");
+        template <typename Archive>
+        static constexpr bool is_constructible_v = traits::HasLoadConstructor<type, Archive> || traits::HasLoadFactory<type, Archive> || std::is_default_constructible_v<type>;
+        // Default constructed and then loaded (neither a load constructor nor a factory)
+        template <typename Archive>
+        static constexpr bool is_default_loaded_v = !traits::HasLoadConstructor<type, Archive> && !traits::HasLoadFactory<type, Archive> && std::is_default_constructible_v<type>;
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Constructs the object in the uninitialized storage pointed to by ptr. If loading
+        /// 			throws nothing is left constructed in the storage. </summary>
+        ///
+        /// <returns>	Pointer to the constructed object. </returns>
+        ///-------------------------------------------------------------------------------------------------
+        template <typename Archive>
+        static inline type* construct_at(type* ptr, InputArchive<Archive>& ar)
+        {
+            auto& archive = static_cast<Archive&>(ar);
+            static_assert(is_constructible_v<Archive>, "Type needs a load constructor, a static load_construct factory or a default constructor. Otherwise specialize Archives::LoadConstructor!");
+            if constexpr (traits::HasLoadConstructor<type, Archive>) {
+                return ::new (static_cast<void*>(ptr)) type(load_construct, archive);
+            }
+            else if constexpr (traits::HasLoadFactory<type, Archive>) {
+                return ::new (static_cast<void*>(ptr)) type(type::load_construct(archive)); // Guaranteed copy elision
+            }
+            else {
+                auto constructed = ::new (static_cast<void*>(ptr)) type();
+                try {
+                    archive(*constructed);
+                }
+                catch (...) {
+                    std::destroy_at(constructed);
+                    throw;
+                }
+                return constructed;
+            }
+        }
+
+        template <typename Archive>
+        static inline type* construct_at(type* ptr, InputArchive<Archive>& ar, std::string_view name)
+        {
+            if constexpr (traits::HasLoadConstructor<type, Archive> || traits::HasLoadFactory<type, Archive>) {
+                detail::LoadConstructProxy<type> proxy{ ptr };
+                try {
+                    ar(createNamedValue(name, proxy));
+                }
+                catch (...) {
+                    if (proxy.constructed)
+                        std::destroy_at(ptr);
+                    throw;
+                }
+                if (!proxy.constructed) // Archives skipping missing values
+                    throw std::runtime_error{ "Unable to construct '" + std::string{ name } + "' from archive!" };
+                return ptr;
+            }
+            else {
+                static_assert(std::is_default_constructible_v<type>, "Type needs a load constructor, a static load_construct factory or a default constructor. Otherwise specialize Archives::LoadConstructor!");
+                auto constructed = ::new (static_cast<void*>(ptr)) type();
+                try {
+                    ar(createNamedValue(name, *constructed));
+                }
+                catch (...) {
+                    std::destroy_at(constructed);
+                    throw;
+                }
+                return constructed;
+            }
+        }
 
         template <typename Archive>
         static inline type construct(InputArchive<Archive>& ar)
         {
-            type ConstructedType{};
-            ar(ConstructedType);
-            return ConstructedType;
+            auto& archive = static_cast<Archive&>(ar);
+            static_assert(is_constructible_v<Archive>, "Type needs a load constructor, a static load_construct factory or a default constructor. Otherwise specialize Archives::LoadConstructor!");
+            if constexpr (traits::HasLoadConstructor<type, Archive>) {
+                return type(load_construct, archive);
+            }
+            else if constexpr (traits::HasLoadFactory<type, Archive>) {
+                return type::load_construct(archive);
+            }
+            else {
+                type ConstructedType{};
+                archive(ConstructedType);
+                return ConstructedType;
+            }
+        }
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Appends an object loaded from the current position of the archive to the container.
+        /// 			Containers with emplace_back construct it in place (load constructor) or load into
+        /// 			the emplaced object (default loaded); no intermediate object is created. Other
+        /// 			containers insert the object returned by construct. If loading throws the
+        /// 			container is left as before. </summary>
+        ///-------------------------------------------------------------------------------------------------
+        template <typename Container, typename Archive>
+        static inline void emplace_into(Container& container, InputArchive<Archive>& ar)
+        {
+            auto& archive = static_cast<Archive&>(ar);
+            static_assert(is_constructible_v<Archive>, "Type needs a load constructor, a static load_construct factory or a default constructor. Otherwise specialize Archives::LoadConstructor!");
+            if constexpr (traits::HasLoadConstructor<type, Archive> && requires { container.emplace_back(load_construct, archive); }) {
+                container.emplace_back(load_construct, archive);
+            }
+            else if constexpr (is_default_loaded_v<Archive> && requires { container.emplace_back(); container.pop_back(); }) {
+                auto& constructed = container.emplace_back();
+                try {
+                    archive(constructed);
+                }
+                catch (...) {
+                    container.pop_back();
+                    throw;
+                }
+            }
+            else {
+                container.insert(container.end(), construct(ar));
+            }
+        }
+
+        template <typename Archive>
+        static inline type constructWithName(InputArchive<Archive>& ar, std::string_view name)
+        {
+            if constexpr (traits::HasLoadConstructor<type, Archive> || traits::HasLoadFactory<type, Archive>) {
+                return moveFromStorage(ar, name);
+            }
+            else {
+                type ConstructedType{};
+                ar(createNamedValue(name, ConstructedType));
+                return ConstructedType;
+            }
         }
 
         template <typename Archive>
         static inline type constructWithName(InputArchive<Archive>& ar, char const * const name)
         {
-            type ConstructedType{};
-            ar(createNamedValue(name, ConstructedType));
-            return ConstructedType;
+            return constructWithName(ar, std::string_view{ name });
         }
 
         template <typename Archive>
         static inline type constructWithName(InputArchive<Archive>& ar, const std::string& name)
         {
-            type ConstructedType{};
-            ar(createNamedValue(name, ConstructedType));
-            return ConstructedType;
+            return constructWithName(ar, std::string_view{ name });
         }
 
         template <typename Archive>
@@ -69,6 +237,17 @@ namespace Archives
             return constructWithName(ar, name);
         }
 
+    private:
+        // The name must be resolved by the archive first; thus one move out of local storage
+        template <typename Archive>
+        static inline type moveFromStorage(InputArchive<Archive>& ar, std::string_view name)
+        {
+            alignas(type) std::byte storage[sizeof(type)];
+            auto constructed = construct_at(reinterpret_cast<type*>(storage), ar, name);
+            type ConstructedType{ std::move(*constructed) };
+            std::destroy_at(constructed);
+            return ConstructedType;
+        }
     };
 }
 
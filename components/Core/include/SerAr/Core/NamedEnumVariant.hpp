@@ -1,7 +1,16 @@
 #pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
 #include <fmt/core.h>
 
 #include <MyCEL/basics/enumhelpers.h>
@@ -18,6 +27,115 @@ namespace SerAr {
             t.value;
             t.variant;
         };
+        // The enum variant type lists all enumerators in a static member `enum_values` (e.g. a std::array<enum_type,N>)
+        template<typename T>
+        concept EnumVariantWithValues = EnumVariant<T> && requires {
+            std::begin(std::remove_cvref_t<T>::enum_values);
+            std::end(std::remove_cvref_t<T>::enum_values);
+        };
+        // enum_values is constexpr: loading dispatches over it without MyCEL::enum_switch
+        template<typename T>
+        concept EnumVariantWithConstexprValues = EnumVariantWithValues<T> && requires {
+            typename std::integral_constant<std::size_t, std::size(std::remove_cvref_t<T>::enum_values)>;
+        };
+    }
+
+    // How NamedEnumVariant stores the enum value
+    enum class EnumEncoding { Name, Integer };
+
+    namespace detail {
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Perfect hash (hash and displace) from the enumerator names to their values.
+        /// 			Built once per enum type from to_string of all enum_values; a lookup costs two hashes
+        /// 			and one string compare independent of the number of enumerators. </summary>
+        ///-------------------------------------------------------------------------------------------------
+        template<typename Enum>
+        class EnumNameTable
+        {
+            static constexpr std::uint32_t empty{ ~std::uint32_t{ 0 } };
+        public:
+            template<typename Values>
+            explicit EnumNameTable(const Values& values)
+            {
+                for (const auto& value : values) {
+                    mValues.push_back(value);
+                    mNames.emplace_back(to_string(value));
+                }
+                auto sorted{ mNames };
+                std::sort(sorted.begin(), sorted.end());
+                if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+                    throw std::logic_error{ "Enumerator names are not unique!" };
+
+                const auto count = mNames.size();
+                mBuckets.assign(std::max<std::size_t>(count / 2, 1), 0);
+                mSlots.assign(std::bit_ceil(std::max<std::size_t>(count + count / 4, 1)), empty);
+
+                std::vector<std::vector<std::uint32_t>> buckets(mBuckets.size());
+                for (std::uint32_t i = 0; i < count; ++i)
+                    buckets[hash(mNames[i], 0) % mBuckets.size()].push_back(i);
+                std::vector<std::size_t> order(buckets.size());
+                for (std::size_t i = 0; i < order.size(); ++i)
+                    order[i] = i;
+                std::sort(order.begin(), order.end(), [&buckets](auto lhs, auto rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+                std::vector<std::size_t> placed;
+                for (const auto bucket : order) {
+                    if (buckets[bucket].empty())
+                        break;
+                    for (std::uint32_t seed = 1;; ++seed) {
+                        placed.clear();
+                        for (const auto index : buckets[bucket]) {
+                            const auto slot = hash(mNames[index], seed) & (mSlots.size() - 1);
+                            if (mSlots[slot] != empty || std::find(placed.begin(), placed.end(), slot) != placed.end())
+                                break;
+                            placed.push_back(slot);
+                        }
+                        if (placed.size() == buckets[bucket].size()) {
+                            for (std::size_t i = 0; i < placed.size(); ++i)
+                                mSlots[placed[i]] = buckets[bucket][i];
+                            mBuckets[bucket] = seed;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            const Enum* find(std::string_view name) const noexcept
+            {
+                const auto seed = mBuckets[hash(name, 0) % mBuckets.size()];
+                const auto index = mSlots[hash(name, seed) & (mSlots.size() - 1)];
+                if (index == empty || mNames[index] != name)
+                    return nullptr;
+                return &mValues[index];
+            }
+
+            // Name of a known enumerator; nullptr otherwise
+            const std::string* name(Enum value) const noexcept
+            {
+                const auto it = std::find(mValues.begin(), mValues.end(), value);
+                return it == mValues.end() ? nullptr : &mNames[static_cast<std::size_t>(it - mValues.begin())];
+            }
+
+            template<typename Values>
+            static const EnumNameTable& get(const Values& values)
+            {
+                static const EnumNameTable table{ values };
+                return table;
+            }
+        private:
+            std::vector<Enum>           mValues;
+            std::vector<std::string>    mNames;
+            std::vector<std::uint32_t>  mBuckets;   // Seed of the second hash per bucket of the first
+            std::vector<std::uint32_t>  mSlots;     // Index into mValues/mNames
+
+            static std::uint64_t hash(std::string_view str, std::uint32_t seed) noexcept
+            {
+                std::uint64_t h{ 14695981039346656037ull ^ (std::uint64_t{ seed } * 0x9E3779B97F4A7C15ull) };
+                for (const auto c : str)
+                    h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+                return h ^ (h >> 32);
+            }
+        };
     }
 
     template<concepts::EnumVariant T>
@@ -39,12 +157,13 @@ namespace SerAr {
         const std::string enum_name;
         const std::string type_name;
         internal_type value;
+        const EnumEncoding encoding{ EnumEncoding::Name }; // Integer: stores the underlying value (for HDF5, MATLAB, ...)
 
         //Disallow assignment of NamedValue; 
         //could run in problems with r value typed NamedValue
         NamedEnumVariant & operator=(const NamedEnumVariant &) = delete;
-        BASIC_ALWAYS_INLINE explicit NamedEnumVariant(std::string enumname, std::string nametype, T&& val) 
-            : enum_name(std::move(enumname)), type_name(std::move(nametype)), value(std::forward<T>(val)) {}
+        BASIC_ALWAYS_INLINE explicit NamedEnumVariant(std::string enumname, std::string nametype, T&& val, EnumEncoding enc = EnumEncoding::Name) 
+            : enum_name(std::move(enumname)), type_name(std::move(nametype)), value(std::forward<T>(val)), encoding(enc) {}
 
         template<std::remove_cvref_t<underlying_enum_type> EValue, typename = void>
         struct enum_variant_switch_case_functor {
@@ -75,7 +194,7 @@ namespace SerAr {
                 {
                     variant = variant_type{};
                 }
-                ar(Archives::createNamedValue(name, std::get<variant_type>(variant)));
+                ar(Archives::createNamedValue(std::string_view{ name }, std::get<variant_type>(variant)));
             }
             template<typename Archive>
             void operator()(std::remove_cvref_t<underlying_enum_variant_type>& variant, Archive &ar)
@@ -120,13 +239,24 @@ namespace SerAr {
             auto& enum_value = value.value;
             auto& enum_variant = value.variant;
             if constexpr (!std::is_reference_v<underlying_enum_type>) {
-                ar(Archives::createNamedValue(enum_name,to_string(enum_value)));
+                if (encoding == EnumEncoding::Integer) {
+                    ar(Archives::createNamedValue(std::string_view{ enum_name }, static_cast<enum_integer_type>(enum_value)));
+                }
+                else if constexpr (concepts::EnumVariantWithValues<T>) {
+                    if (const auto name = name_table().name(enum_value))
+                        ar(Archives::createNamedValue(std::string_view{ enum_name }, *name));
+                    else
+                        ar(Archives::createNamedValue(std::string_view{ enum_name }, to_string(enum_value)));
+                }
+                else {
+                    ar(Archives::createNamedValue(std::string_view{ enum_name },to_string(enum_value)));
+                }
             }
             if(type_name.empty()) {
                 std::visit([&](auto&& arg) { ar(arg); }, enum_variant);
             }
             else {
-                std::visit([&](auto&& arg) { ar(Archives::NamedValue(type_name,arg)); }, enum_variant);
+                std::visit([&](auto&& arg) { ar(Archives::NamedValue(std::string_view{ type_name },arg)); }, enum_variant);
             }
         }
         template<typename Archive>
@@ -135,22 +265,72 @@ namespace SerAr {
             using MyCEL::enum_switch;
             auto& enum_value = value.value;
             auto& enum_variant = value.variant;
-            std::string enum_str;
-            ar(Archives::createNamedValue(enum_name,enum_str));
-            enum_value = from_string(enum_str,enum_value);
-            if(type_name.empty()) {
+            if (encoding == EnumEncoding::Integer) {
+                enum_integer_type enum_int{};
+                ar(Archives::createNamedValue(std::string_view{ enum_name }, enum_int));
+                enum_value = static_cast<std::remove_cvref_t<underlying_enum_type>>(enum_int);
+                if constexpr (concepts::EnumVariantWithValues<T>) {
+                    if (!name_table().name(enum_value)) {
+                        std::string error {fmt::format("Invalid value {} for enum named: '{}'", enum_int, enum_name)};
+                        throw std::out_of_range{error.c_str()};
+                    }
+                }
+            }
+            else {
+                // Reused between loads so reading the name does not allocate once the buffer has grown;
+                // it is not used any more once the variant is dispatched below (which may load nested enums)
+                static thread_local std::string enum_str;
+                enum_str.clear();
+                ar(Archives::createNamedValue(std::string_view{ enum_name },enum_str));
+                if constexpr (concepts::EnumVariantWithValues<T>) {
+                    const auto found = name_table().find(enum_str);
+                    enum_value = found ? *found : from_string(enum_str,enum_value);
+                }
+                else {
+                    enum_value = from_string(enum_str,enum_value);
+                }
+            }
+            if constexpr (concepts::EnumVariantWithConstexprValues<T>) {
+                constexpr auto count = std::size(std::remove_cvref_t<T>::enum_values);
+                if(type_name.empty())
+                    run_enum_values(enum_value, std::make_index_sequence<count>{}, enum_variant, ar);
+                else
+                    run_enum_values(enum_value, std::make_index_sequence<count>{}, type_name, enum_variant, ar);
+            }
+            else if(type_name.empty()) {
                 enum_switch::run<std::remove_cvref_t<underlying_enum_type>, enum_switch_case_functor>(enum_value,enum_variant,ar);
             } else {
                 enum_switch::run<std::remove_cvref_t<underlying_enum_type>, enum_switch_case_functor>(enum_value,type_name,enum_variant,ar);
             }
         }
+    private:
+        // Calls the functor of the enumerator equal to enum_value
+        template<std::size_t... Is, typename... Args>
+        void run_enum_values(std::remove_cvref_t<underlying_enum_type> enum_value, std::index_sequence<Is...>, Args&... args)
+        {
+            constexpr auto& values = std::remove_cvref_t<T>::enum_values;
+            const bool found = ((enum_value == values[Is] ? (enum_switch_case_functor<values[Is]>{}(args...), true) : false) || ...);
+            if (!found) {
+                std::string error {fmt::format("Invalid value for enum named: '{}'", enum_name)};
+                throw std::out_of_range{error.c_str()};
+            }
+        }
+        // Promoted so that char sized enums are stored as numbers
+        using enum_integer_type = decltype(+std::declval<std::underlying_type_t<std::remove_cvref_t<underlying_enum_type>>>());
+
+        static const detail::EnumNameTable<std::remove_cvref_t<underlying_enum_type>>& name_table() requires concepts::EnumVariantWithValues<T>
+        {
+            return detail::EnumNameTable<std::remove_cvref_t<underlying_enum_type>>::get(std::remove_cvref_t<T>::enum_values);
+        }
     };
     template<concepts::EnumVariant T>
     NamedEnumVariant(std::string, std::string, T&& value) -> NamedEnumVariant<T>;
+    template<concepts::EnumVariant T>
+    NamedEnumVariant(std::string, std::string, T&& value, EnumEncoding) -> NamedEnumVariant<T>;
 
     template<typename T>
-    inline NamedEnumVariant<T> createNamedEnumVariant(std::string ename,std::string tname, T&& value)
+    inline NamedEnumVariant<T> createNamedEnumVariant(std::string ename,std::string tname, T&& value, EnumEncoding encoding = EnumEncoding::Name)
     {
-        return NamedEnumVariant<T>{std::move(ename),std::move(tname), std::forward<T>(value)};
+        return NamedEnumVariant<T>{std::move(ename),std::move(tname), std::forward<T>(value), encoding};
     }
 }
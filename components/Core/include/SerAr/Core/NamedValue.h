@@ -14,9 +14,12 @@
 #include <type_traits>
 #include <utility>
 #include <string>
+#include <string_view>
 
 #include <MyCEL/basics/BasicMacros.h>
 
+#include "NamedValueName.h"
+
 namespace Archives
 {
     ///-------------------------------------------------------------------------------------------------
@@ -40,8 +43,11 @@ namespace Archives
                                                 typename std::remove_cv<T>::type,
                                                 typename std::conditional<std::is_lvalue_reference<T>::value,
                                                                         T&,	typename std::decay<T>::type>::type>::type;
+        // A NamedValue holding a reference does not own the value; constness of the NamedValue does not propagate
+        using const_reference = std::conditional_t<std::is_lvalue_reference_v<internal_type>, internal_type, const internal_type&>;
+        using reference = internal_type&;
     public:
-        const std::string name;
+        const NamedValueName name;
         internal_type val;
 
         //Disallow assignment of NamedValue; 
@@ -54,31 +60,38 @@ namespace Archives
         ///-------------------------------------------------------------------------------------------------
         /// <summary>	Constructor for named value. </summary>
         ///
-        /// <param name="name"> 	The name of the value. </param>
+        /// <param name="name"> 	The name of the value. String literals are not copied. </param>
         /// <param name="value">	[in,out] The value. </param>
         ///-------------------------------------------------------------------------------------------------
-        BASIC_ALWAYS_INLINE explicit NamedValue(std::string valname, T&& value) : name(std::move(valname)), val(std::forward<T>(value)) {}
+        BASIC_ALWAYS_INLINE explicit NamedValue(NamedValueName valname, T&& value) : name(std::move(valname)), val(std::forward<T>(value)) {}
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Gets the value. Never copies the stored value. </summary>
+        ///
+        /// <returns>	Reference to the value </returns>
+        ///-------------------------------------------------------------------------------------------------
+        BASIC_ALWAYS_INLINE const_reference getValue() const noexcept { return val; }
 
         ///-------------------------------------------------------------------------------------------------
-        /// <summary>	Gets the value. </summary>
+        /// <summary>	Gets the value. Never copies the stored value. </summary>
         ///
-        /// <returns>	The Value </returns>
+        /// <returns>	Reference to the value </returns>
         ///-------------------------------------------------------------------------------------------------
-        BASIC_ALWAYS_INLINE internal_type getValue() const noexcept { return val; }
+        BASIC_ALWAYS_INLINE reference getValue() noexcept { return val; }
 
         ///-------------------------------------------------------------------------------------------------
         /// <summary>	Gets the name. </summary>
         ///
         /// <returns>	The name of the value. </returns>
         ///-------------------------------------------------------------------------------------------------
-        BASIC_ALWAYS_INLINE const std::string& getName() const noexcept { return name; }
+        BASIC_ALWAYS_INLINE std::string_view getName() const noexcept { return name.view(); }
     };
 
     template<typename T>
-    NamedValue(std::string valname, T&& value) -> NamedValue<T>;
+    NamedValue(NamedValueName valname, T&& value) -> NamedValue<T>;
 
     template<typename T>
-    inline NamedValue<T> createNamedValue(std::string name, T&& value)
+    inline NamedValue<T> createNamedValue(NamedValueName name, T&& value)
     {
         return NamedValue<T>{std::move(name), std::forward<T>(value)};
     }
@@ -0,0 +1,82 @@
+///---------------------------------------------------------------------------------------------------
+// file:		NamedValueName.h
+//
+// summary: 	Declares the name type used by NamedValue
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_NamedValueName_H
+#define INC_NamedValueName_H
+///---------------------------------------------------------------------------------------------------
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace Archives
+{
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Name of a NamedValue.
+    ///
+    /// 			String literals and std::string_view are only referenced and never copied, so
+    /// 			ar(createNamedValue("myint", val.myint)) or ARCHIVE_CREATE_NV does not allocate.
+    /// 			The referenced characters must outlive the NamedValue (always true for literals).
+    /// 			Everything else (std::string, char pointers) is copied into an owned string.
+    ///			   </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class NamedValueName
+    {
+    public:
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Constructor for string literals. Only references the literal. </summary>
+        ///
+        /// <param name="literal">	The string literal. </param>
+        ///-------------------------------------------------------------------------------------------------
+        template<std::size_t N>
+        constexpr NamedValueName(const char (&literal)[N]) noexcept
+            : mView(literal, std::char_traits<char>::length(literal)) {}
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Constructor for string views. Only references the viewed characters. </summary>
+        ///
+        /// <param name="name">	The name. </param>
+        ///-------------------------------------------------------------------------------------------------
+        constexpr NamedValueName(std::string_view name) noexcept : mView(name) {}
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Constructor for owned names. </summary>
+        ///
+        /// <param name="name">	The name. </param>
+        ///-------------------------------------------------------------------------------------------------
+        NamedValueName(std::string name) : mStorage(std::move(name)), mView(mStorage), mOwning(true) {}
+
+        // Templated so that string literals prefer the non copying constructor above
+        template<typename CharPtr> requires (std::same_as<CharPtr, const char*> || std::same_as<CharPtr, char*>)
+        NamedValueName(CharPtr name) : NamedValueName(std::string{ name }) {}
+
+        NamedValueName(const NamedValueName& other)
+            : mStorage(other.mStorage), mView(other.mOwning ? std::string_view{ mStorage } : other.mView), mOwning(other.mOwning) {}
+        NamedValueName(NamedValueName&& other) noexcept
+            : mStorage(std::move(other.mStorage)), mView(other.mOwning ? std::string_view{ mStorage } : other.mView), mOwning(other.mOwning) {}
+
+        NamedValueName& operator=(const NamedValueName&) = delete;
+        NamedValueName& operator=(NamedValueName&&) = delete;
+
+        constexpr std::string_view view() const noexcept { return mView; }
+        constexpr operator std::string_view() const noexcept { return mView; }
+        constexpr bool isOwning() const noexcept { return mOwning; }
+
+        friend constexpr bool operator==(const NamedValueName& lhs, std::string_view rhs) noexcept { return lhs.mView == rhs; }
+    private:
+        std::string         mStorage{};
+        std::string_view    mView;
+        bool                mOwning{ false };
+    };
+}
+
+#endif	// INC_NamedValueName_H
+// end of NamedValueName.h
+///---------------------------------------------------------------------------------------------------
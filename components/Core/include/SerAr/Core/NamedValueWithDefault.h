@@ -0,0 +1,103 @@
+///---------------------------------------------------------------------------------------------------
+// file:		NamedValueWithDefault.h
+//
+// summary: 	Declares the named value with default class and the support for optional fields
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_NamedValueWithDefault_H
+#define INC_NamedValueWithDefault_H
+///---------------------------------------------------------------------------------------------------
+#include <concepts>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <MyCEL/basics/BasicMacros.h>
+
+#include <SerAr/Core/NamedValue.h>
+
+namespace Archives
+{
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	NamedValue which is set to a default value if an input archive does not contain it.
+    /// 			Output archives store it like a NamedValue.
+    ///
+    /// 			Archives implementing contains() (see SerAr::HasFieldLookup) check for the field
+    /// 			before loading it, so a missing field does not throw. Other archives load the
+    /// 			value like a NamedValue. </summary>
+    ///
+    /// <typeparam name="T">	  	Type of the value stored (usually a reference). </typeparam>
+    /// <typeparam name="Default">	Type of the default value; must be assignable to the value. </typeparam>
+    ///-------------------------------------------------------------------------------------------------
+    template <typename T, typename Default>
+    class NamedValueWithDefault
+    {
+    public:
+        using type = T;
+        using internal_type = typename std::conditional<std::is_lvalue_reference<T>::value, T&, typename std::decay<T>::type>::type;
+        using const_reference = std::conditional_t<std::is_lvalue_reference_v<internal_type>, internal_type, const internal_type&>;
+        using reference = internal_type&;
+
+        const NamedValueName name;
+        internal_type val;
+        const Default def;
+
+        NamedValueWithDefault& operator=(const NamedValueWithDefault&) = delete;
+
+        BASIC_ALWAYS_INLINE explicit NamedValueWithDefault(NamedValueName valname, T&& value, Default defvalue)
+            : name(std::move(valname)), val(std::forward<T>(value)), def(std::move(defvalue)) {}
+
+        BASIC_ALWAYS_INLINE const_reference getValue() const noexcept { return val; }
+        BASIC_ALWAYS_INLINE reference getValue() noexcept { return val; }
+        BASIC_ALWAYS_INLINE const Default& getDefault() const noexcept { return def; }
+        BASIC_ALWAYS_INLINE std::string_view getName() const noexcept { return name.view(); }
+    };
+
+    template<typename T, typename Default>
+    inline NamedValueWithDefault<T, std::decay_t<Default>> createNamedValueWithDefault(NamedValueName name, T&& value, Default&& defvalue)
+    {
+        return NamedValueWithDefault<T, std::decay_t<Default>>{ std::move(name), std::forward<T>(value), std::forward<Default>(defvalue) };
+    }
+
+    namespace traits
+    {
+        template<typename T>
+        struct is_optional : std::false_type {};
+        template<typename T>
+        struct is_optional<std::optional<T>> : std::true_type {};
+        template<typename T>
+        static constexpr bool is_optional_v = is_optional<std::remove_cvref_t<T>>::value;
+
+        template<typename T>
+        struct is_NamedValueWithDefault : std::false_type {};
+        template<typename T, typename Default>
+        struct is_NamedValueWithDefault<NamedValueWithDefault<T, Default>> : std::true_type {};
+        template<typename T>
+        static constexpr bool is_NamedValueWithDefault_v = is_NamedValueWithDefault<std::remove_cvref_t<T>>::value;
+    }
+}
+
+namespace SerAr
+{
+    // NamedValue holding a std::optional: empty optionals are not saved; missing fields are loaded as std::nullopt
+    template<typename T>
+    concept IsOptionalNamedValue = ::Archives::is_NamedValue_v<T> && ::Archives::traits::is_optional_v<typename std::remove_cvref_t<T>::type>;
+    // Named fields an input archive may not contain
+    template<typename T>
+    concept IsDefaultableField = IsOptionalNamedValue<T> || ::Archives::traits::is_NamedValueWithDefault_v<T>;
+
+    // Input archives able to check for a field with the given name at the current position without throwing
+    template<typename Archive>
+    concept HasFieldLookup = requires(Archive& ar, std::string_view name) {
+        { ar.contains(name) } -> std::same_as<bool>;
+    };
+}
+
+#endif	// INC_NamedValueWithDefault_H
+// end of NamedValueWithDefault.h
+///---------------------------------------------------------------------------------------------------
@@ -0,0 +1,159 @@
+///---------------------------------------------------------------------------------------------------
+// file:		ObjectTracker.h
+//
+// summary: 	Declares the object tracker used to store objects shared by std::shared_ptr only once
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_ObjectTracker_H
+#define INC_ObjectTracker_H
+///---------------------------------------------------------------------------------------------------
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+#include <SerAr/Core/NamedValue.h>
+
+namespace Archives
+{
+    namespace traits
+    {
+        template<typename T>
+        struct is_shared_ptr : std::false_type {};
+        template<typename T>
+        struct is_shared_ptr<std::shared_ptr<T>> : std::true_type {};
+        template<typename T>
+        static constexpr bool is_shared_ptr_v = is_shared_ptr<std::remove_cvref_t<T>>::value;
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Remembers the objects already passed through an archive.
+    ///
+    /// 			Saving: maps the address and type of an object to the location it was first written to;
+    /// 			the object is kept alive until clear() is called or the tracker is destroyed.
+    /// 			Loading: maps the identity of a stored object (as given by the archive) to the
+    /// 			object created for it. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class ObjectTracker
+    {
+    public:
+        // Location the object was first written to; nullptr if it was not written yet.
+        // Objects are identified by address and type: a struct and its first member share the address.
+        template<typename T>
+        const std::string* findSaved(const std::shared_ptr<T>& object) const
+        {
+            const auto it = mSaved.find(SavedKey{ object.get(), std::type_index{ typeid(T) } });
+            return it == mSaved.end() ? nullptr : &it->second.location;
+        }
+        // The object is kept alive so that its address cannot be reused by another object while tracked
+        template<typename T>
+        void addSaved(std::shared_ptr<T> object, std::string location)
+        {
+            const SavedKey key{ object.get(), std::type_index{ typeid(T) } };
+            mSaved.emplace(key, Saved{ std::shared_ptr<const void>{ std::move(object) }, std::move(location) });
+        }
+
+        // Object already loaded for the identity; empty if none. Throws if it was loaded as a different type.
+        template<typename T>
+        std::shared_ptr<T> findLoaded(const std::string& identity) const
+        {
+            const auto it = mLoaded.find(identity);
+            if (it == mLoaded.end())
+                return nullptr;
+            if (it->second.type != std::type_index{ typeid(T) })
+                throw std::runtime_error{ "Shared object at '" + identity + "' was already loaded as a different type!" };
+            return std::static_pointer_cast<T>(it->second.object);
+        }
+        template<typename T>
+        void addLoaded(std::string identity, std::shared_ptr<T> object)
+        {
+            mLoaded.emplace(std::move(identity), Loaded{ std::move(object), std::type_index{ typeid(T) } });
+        }
+        // Forgets an object whose loading failed
+        inline void eraseLoaded(const std::string& identity)
+        {
+            mLoaded.erase(identity);
+        }
+
+        // Forgets all objects; afterwards shared objects are written in full again
+        inline void clear() noexcept
+        {
+            mSaved.clear();
+            mLoaded.clear();
+        }
+        inline bool empty() const noexcept { return mSaved.empty() && mLoaded.empty(); }
+    private:
+        struct SavedKey {
+            const void*             address;
+            std::type_index         type;
+            bool operator==(const SavedKey&) const noexcept = default;
+        };
+        struct SavedKeyHash {
+            std::size_t operator()(const SavedKey& key) const noexcept
+            {
+                return std::hash<const void*>{}(key.address) ^ (key.type.hash_code() << 1);
+            }
+        };
+        struct Saved {
+            std::shared_ptr<const void> object;
+            std::string                 location;
+        };
+        struct Loaded {
+            std::shared_ptr<void>   object;
+            std::type_index         type;
+        };
+        std::unordered_map<SavedKey, Saved, SavedKeyHash>   mSaved{};
+        std::unordered_map<std::string, Loaded>             mLoaded{};
+    };
+}
+
+namespace SerAr
+{
+    template<typename T>
+    concept IsSharedPointer = ::Archives::traits::is_shared_ptr_v<T>
+                              || (::Archives::is_NamedValue_v<T> && ::Archives::traits::is_shared_ptr_v<typename std::remove_cvref_t<T>::type>);
+
+    // Output archives storing a later occurrence of a shared object as reference to its first one.
+    // An empty name refers to the current (unnamed) value.
+    template<typename Archive>
+    concept HasSharedObjectSave = requires(Archive& ar, std::string_view name, const std::string& location) {
+        { ar.objectTracker() } -> std::same_as<::Archives::ObjectTracker&>;
+        { ar.objectLocation(name) } -> std::convertible_to<std::string>;
+        ar.saveObjectReference(name, location);
+    };
+    // Input archives resolving references written by a HasSharedObjectSave archive. objectIdentity
+    // returns the same string for a stored object and all references to it.
+    template<typename Archive>
+    concept HasSharedObjectLoad = requires(Archive& ar, std::string_view name) {
+        { ar.objectTracker() } -> std::same_as<::Archives::ObjectTracker&>;
+        { ar.objectIdentity(name) } -> std::convertible_to<std::string>;
+    };
+
+    // Input archives which can position themselves at the stored object of an identity; the returned scope
+    // restores the position. Shared objects are then loaded from there, so a reference resolves even if its
+    // target was not loaded before (e.g. only the reference is loaded or the load order differs).
+    template<typename Archive>
+    concept HasSharedObjectScope = HasSharedObjectLoad<Archive> && requires(Archive& ar, const std::string& identity) {
+        ar.objectScope(identity);
+    };
+
+    template<typename Type, typename Ar>
+    concept UseSharedObjectSave = IsSharedPointer<Type> && HasSharedObjectSave<Ar>;
+    template<typename Type, typename Ar>
+    concept UseSharedObjectLoad = IsSharedPointer<Type> && HasSharedObjectLoad<Ar>;
+}
+
+#endif	// INC_ObjectTracker_H
+// end of ObjectTracker.h
+///---------------------------------------------------------------------------------------------------
@@ -15,7 +15,15 @@
 
 #include <MyCEL/basics/BasicMacros.h>
 #include <SerAr/Core/ArchiveHelper.h>
+#include <SerAr/Core/NamedValueWithDefault.h>
+#include <SerAr/Core/ObjectTracker.h>
+#ifdef SERAR_HAS_FIELD_OBSERVER
+#include <SerAr/Core/FieldObserver.h>
+#endif
 #include <cassert>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
 namespace Archives
 {
@@ -65,16 +73,67 @@ namespace Archives
         }
 
         // Does all the work for only element
-        template <typename T>
+        template <typename T> requires (!UseSharedObjectSave<T, ArchiveType> && !IsDefaultableField<T>)
         inline void worksplitter(T&& head)
         {			
             //std::cout << "Called: " << __FUNCTION__  << "\n" << " with Type: " << typeid(head).name() << std::endl;
             // Would be nice if we could forward here!
+#ifdef SERAR_HAS_FIELD_OBSERVER
+            if (mFieldObserver.observer) {
+                FieldObserverState::Scope field{ mFieldObserver, ::SerAr::detail::field_name(head), writtenBytes() };
+                self().beforework(head);
+                self().dowork(head);
+                self().afterwork(head);
+                field.template finish<HasBytesWritten<ArchiveType>>(FieldDirection::Save, head, writtenBytes());
+                return;
+            }
+#endif
             self().beforework(head);
             self().dowork(head);
             self().afterwork(head);
         }
 
+        // std::shared_ptr: the pointee is written on its first occurrence only; later ones become references to it
+        template <typename T> requires (UseSharedObjectSave<T, ArchiveType>)
+        inline void worksplitter(T&& head)
+        {
+            std::string_view name{};
+            if constexpr (is_NamedValue_v<T>)
+                name = head.getName();
+            const auto& pointer = [&]() -> decltype(auto) {
+                if constexpr (is_NamedValue_v<T>)
+                    return head.getValue();
+                else
+                    return head;
+            }();
+            if (!pointer)
+                throw std::runtime_error{ "Cannot save an empty std::shared_ptr '" + std::string{ name } + "'!" };
+
+            auto& tracker = self().objectTracker();
+            if (const auto location = tracker.findSaved(pointer)) {
+                self().saveObjectReference(name, *location);
+                return;
+            }
+            tracker.addSaved(pointer, self().objectLocation(name)); // Before the pointee so that cycles end here
+            if constexpr (is_NamedValue_v<T>)
+                worksplitter(createNamedValue(name, *pointer));
+            else
+                worksplitter(*pointer);
+        }
+
+        // std::optional is only written if it holds a value; NamedValueWithDefault is written as NamedValue
+        template <typename T> requires (IsDefaultableField<T>)
+        inline void worksplitter(T&& head)
+        {
+            if constexpr (IsOptionalNamedValue<T>) {
+                if (head.getValue())
+                    worksplitter(createNamedValue(head.getName(), *head.getValue()));
+            }
+            else {
+                worksplitter(createNamedValue(head.getName(), head.getValue()));
+            }
+        }
+
         // Compile Time Recursion to unwind parameter list (has to be an overload for ADL lookup)
         template <typename T, typename ... Other>
         inline void worksplitter(T&& head, Other&& ... tail)
@@ -180,6 +239,18 @@ namespace Archives
 //            return self();
 //        }
 
+#ifdef SERAR_HAS_FIELD_OBSERVER
+        FieldObserverState mFieldObserver{};
+
+        inline std::size_t writtenBytes() const noexcept
+        {
+            if constexpr (HasBytesWritten<ArchiveType>)
+                return static_cast<std::size_t>(static_cast<const ArchiveType&>(*this).bytesWritten());
+            else
+                return 0;
+        }
+#endif
+
     protected:
         constexpr OutputArchive(ArchiveType * const) noexcept {}
         
@@ -194,6 +265,15 @@ namespace Archives
             self().worksplitter(std::forward<Types>(args)...);
             return self();
         }
+#ifdef SERAR_HAS_FIELD_OBSERVER
+        // Installs an observer which gets called for every saved field. Pass nullptr to remove it.
+        // The observer is not owned and must outlive the archive or be removed before.
+        inline IFieldObserver* setFieldObserver(IFieldObserver* observer) noexcept
+        {
+            return std::exchange(mFieldObserver.observer, observer);
+        }
+        inline IFieldObserver* getFieldObserver() const noexcept { return mFieldObserver.observer; }
+#endif
     };
 }
 
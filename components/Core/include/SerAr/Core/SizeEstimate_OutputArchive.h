@@ -0,0 +1,226 @@
+///---------------------------------------------------------------------------------------------------
+// file:		SizeEstimate_OutputArchive.h
+//
+// summary: 	Declares the size estimating (dry run) output archive class
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_SizeEstimate_OutputArchive_H
+#define INC_SizeEstimate_OutputArchive_H
+///---------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <SerAr/Core/NamedValue.h>
+#include <SerAr/Core/OutputArchive.h>
+
+namespace Archives
+{
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Size and shape of everything passed to a SizeEstimate_OutputArchive. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    struct SizeEstimate
+    {
+        // Tree shape
+        std::size_t groups{ 0 };            // Named values holding structs or containers of them (HDF5 groups, MATLAB structs, JSON objects, ConfigFile sections)
+        std::size_t datasets{ 0 };          // Named values stored as a whole (HDF5 datasets, MATLAB arrays, ConfigFile keys)
+        std::size_t fields{ 0 };            // All named values (groups + datasets)
+        std::size_t scalars{ 0 };           // Number of stored arithmetic values
+        std::size_t max_depth{ 0 };         // Deepest nesting of named values
+        std::size_t name_bytes{ 0 };        // Sum of the length of all names
+
+        // Encoded sizes
+        std::size_t payload_bytes{ 0 };     // Exact size of the raw data (what HDF5/MATLAB store without metadata)
+        std::size_t json_bytes{ 0 };        // Upper bound of the text written by JSON_OutputArchive
+        std::size_t configfile_bytes{ 0 };  // Upper bound of the text written by ConfigFile_OutputArchive
+    };
+
+    struct SizeEstimate_OutputArchive_Options {
+        std::size_t json_indent_spaces{ 4 };    // Same as JSON_OutputArchive_Options::indent_spaces
+    };
+
+    namespace detail
+    {
+        template<typename T>
+        struct is_std_complex : std::false_type {};
+        template<typename T>
+        struct is_std_complex<std::complex<T>> : std::true_type {};
+
+        template<typename T>
+        concept SizeEstimateScalar = std::is_arithmetic_v<T> || std::is_enum_v<T> || is_std_complex<T>::value;
+        template<typename T>
+        concept SizeEstimateString = std::same_as<T, std::string> || std::same_as<T, std::string_view>;
+        template<typename T>
+        concept SizeEstimateArray = !SizeEstimateString<T> && requires(const T& value) {
+            typename T::value_type;
+            { value.size() } -> std::convertible_to<std::size_t>;
+        } && SizeEstimateScalar<typename T::value_type>;
+        // Stored as a whole like SizeEstimateArray (e.g. std::vector<std::string>)
+        template<typename T>
+        concept SizeEstimateStringArray = std::ranges::range<const T> && SizeEstimateString<std::ranges::range_value_t<const T>>;
+        template<typename T>
+        concept SizeEstimateLeaf = SizeEstimateScalar<T> || SizeEstimateString<T> || SizeEstimateArray<T> || SizeEstimateStringArray<T>;
+        template<typename T>
+        concept SizeEstimateRange = !SizeEstimateLeaf<T> && std::ranges::range<const T>;
+
+        // Longest text representation of a scalar (sign, digits, point and exponent)
+        template<typename T>
+        constexpr std::size_t max_chars() noexcept
+        {
+            if constexpr (is_std_complex<T>::value)
+                return 2 * max_chars<typename T::value_type>() + 2;
+            else if constexpr (std::is_enum_v<T>)
+                return max_chars<std::underlying_type_t<T>>();
+            else if constexpr (std::is_same_v<T, bool>)
+                return 5;
+            else if constexpr (std::is_floating_point_v<T>)
+                return static_cast<std::size_t>(std::numeric_limits<T>::max_digits10) + 8;
+            else
+                return static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 3;
+        }
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Output archive which only walks the serialize()/save() graph and accumulates a
+    /// 			SizeEstimate. Nothing is converted or written, so it can be used to reserve buffers,
+    /// 			presize files or check the shape of the data before writing it (e.g.
+    /// 			HDF5_OutputOptions::useSizeEstimate sizes the metadata blocks of the file). </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class SizeEstimate_OutputArchive : public OutputArchive<SizeEstimate_OutputArchive>
+    {
+        using ThisClass = SizeEstimate_OutputArchive;
+    public:
+        using Options = SizeEstimate_OutputArchive_Options;
+
+        explicit SizeEstimate_OutputArchive(const Options& options = Options{}) : OutputArchive(this), mOptions(options) {
+            mEstimate.json_bytes = 3; // {}\n
+            mEstimate.configfile_bytes = 2;
+        }
+
+        DISALLOW_COPY_AND_ASSIGN(SizeEstimate_OutputArchive)
+
+        template<typename T> requires (detail::SizeEstimateLeaf<std::remove_cvref_t<T>>)
+        inline void save(const NamedValue<T>& value)
+        {
+            addName(value.getName());
+            ++mEstimate.datasets;
+            // key = value\n
+            mEstimate.configfile_bytes += value.getName().size() + 4;
+            addLeaf(value.getValue());
+        }
+
+        template<typename T> requires (!detail::SizeEstimateLeaf<std::remove_cvref_t<T>>)
+        inline void save(const NamedValue<T>& value)
+        {
+            addName(value.getName());
+            ++mEstimate.groups;
+            const auto section_size = mSection;
+            mSection += (mSection == 0 ? 0 : 1) + value.getName().size();
+            // [section]\n ... \n
+            mEstimate.configfile_bytes += mSection + 4;
+            ++mDepth;
+            mEstimate.max_depth = std::max(mEstimate.max_depth, mDepth);
+            this->operator()(value.getValue());
+            --mDepth;
+            mSection = section_size;
+            mEstimate.json_bytes += 2 + indent(mDepth); // {\n} or [\n]
+        }
+
+        template<typename T> requires (detail::SizeEstimateLeaf<T>)
+        inline void save(const T& value)
+        {
+            addLeaf(value);
+        }
+
+        template<typename T> requires (detail::SizeEstimateRange<T>)
+        inline void save(const T& values)
+        {
+            for (const auto& element : values) {
+                mEstimate.json_bytes += 2 + indent(mDepth + 1) + 2; // newline, brackets and comma of the element
+                this->operator()(element);
+            }
+        }
+
+        inline const SizeEstimate& getEstimate() const noexcept { return mEstimate; }
+    private:
+        const Options   mOptions;
+        SizeEstimate    mEstimate{};
+        std::size_t     mDepth{ 0 };
+        std::size_t     mSection{ 0 };  // Length of the current ConfigFile section name
+
+        inline std::size_t indent(std::size_t depth) const noexcept { return mOptions.json_indent_spaces * depth; }
+
+        inline void addName(std::string_view name) noexcept
+        {
+            ++mEstimate.fields;
+            mEstimate.name_bytes += name.size();
+            // \n<indent>"name": <value>,
+            mEstimate.json_bytes += 1 + indent(mDepth + 1) + name.size() + 5;
+        }
+
+        template<typename T>
+        inline void addLeaf(const T& value) noexcept
+        {
+            using Type = std::remove_cvref_t<T>;
+            if constexpr (detail::SizeEstimateScalar<Type>) {
+                ++mEstimate.scalars;
+                mEstimate.payload_bytes += sizeof(Type);
+                mEstimate.json_bytes += detail::max_chars<Type>();
+                mEstimate.configfile_bytes += detail::max_chars<Type>();
+            }
+            else if constexpr (detail::SizeEstimateString<Type>) {
+                mEstimate.payload_bytes += value.size() + 1;
+                mEstimate.json_bytes += 2 + 6 * value.size(); // Worst case: every character escaped as \u00XX
+                mEstimate.configfile_bytes += 2 + 2 * value.size();
+            }
+            else if constexpr (detail::SizeEstimateStringArray<Type>) {
+                // Every string on its own line
+                for (const auto& str : value) {
+                    mEstimate.payload_bytes += str.size() + 1;
+                    mEstimate.json_bytes += 4 + indent(mDepth + 3) + 6 * str.size();
+                    mEstimate.configfile_bytes += 4 + 2 * str.size();
+                }
+                mEstimate.json_bytes += 2 * (4 + indent(mDepth + 2));
+                mEstimate.configfile_bytes += 2;
+            }
+            else {
+                using Element = typename Type::value_type;
+                const auto size = static_cast<std::size_t>(value.size());
+                std::size_t rows = 1;
+                if constexpr (requires { value.rows(); })
+                    rows = static_cast<std::size_t>(value.rows());
+                mEstimate.scalars += size;
+                mEstimate.payload_bytes += size * sizeof(Element);
+                // Every element on its own line, every row in its own array
+                mEstimate.json_bytes += size * (detail::max_chars<Element>() + 2 + indent(mDepth + 3)) + (rows + 1) * (4 + indent(mDepth + 2));
+                // {a, b, c}
+                mEstimate.configfile_bytes += size * (detail::max_chars<Element>() + 2) + 2;
+            }
+        }
+    };
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Estimates the size of the given values without writing them. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename... Types>
+    SizeEstimate estimate_size(Types&&... values)
+    {
+        SizeEstimate_OutputArchive ar{};
+        ar(std::forward<Types>(values)...);
+        return ar.getEstimate();
+    }
+}
+
+#endif	// INC_SizeEstimate_OutputArchive_H
+// end of SizeEstimate_OutputArchive.h
+///---------------------------------------------------------------------------------------------------
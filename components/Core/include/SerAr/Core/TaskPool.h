@@ -0,0 +1,151 @@
+///---------------------------------------------------------------------------------------------------
+// file:		TaskPool.h
+//
+// summary: 	Declares the thread pool used by archives to encode independent values in parallel
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_TaskPool_H
+#define INC_TaskPool_H
+///---------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <MyCEL/basics/BasicMacros.h>
+
+namespace Archives
+{
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Fixed set of worker threads running parallel_for loops.
+    ///
+    /// 			The indices of a loop are claimed one after another by the workers and the calling
+    /// 			thread, so threads which finish early take over the remaining work. parallel_for
+    /// 			called while a loop is already running (e.g. nested containers) runs serially on the
+    /// 			calling thread. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class TaskPool
+    {
+    public:
+        // threads includes the calling thread; thus threads - 1 workers are started
+        explicit TaskPool(std::size_t threads)
+        {
+            for (std::size_t i = 1; i < threads; ++i)
+                mWorkers.emplace_back([this] { run(); });
+        }
+        ~TaskPool() noexcept
+        {
+            {
+                std::lock_guard lock{ mMutex };
+                mStop = true;
+            }
+            mWake.notify_all();
+            for (auto& worker : mWorkers)
+                worker.join();
+        }
+
+        DISALLOW_COPY_AND_ASSIGN(TaskPool)
+
+        inline std::size_t size() const noexcept { return mWorkers.size() + 1; }
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Calls task(index) for every index in [0, count) and waits for all of them. The
+        /// 			first exception thrown by a task is rethrown; remaining indices are skipped. </summary>
+        ///-------------------------------------------------------------------------------------------------
+        void parallel_for(std::size_t count, const std::function<void(std::size_t)>& task)
+        {
+            if (mWorkers.empty() || count < 2 || mBusy.exchange(true)) {
+                for (std::size_t i = 0; i < count; ++i)
+                    task(i);
+                return;
+            }
+            Loop loop{ task, count };
+            {
+                std::lock_guard lock{ mMutex };
+                mLoop = &loop;
+                mFinished = 0;
+                ++mGeneration;
+            }
+            mWake.notify_all();
+            work(loop);
+            {
+                std::unique_lock lock{ mMutex };
+                mDone.wait(lock, [this] { return mFinished == mWorkers.size(); });
+                mLoop = nullptr;
+            }
+            mBusy = false;
+            if (loop.error)
+                std::rethrow_exception(loop.error);
+        }
+    private:
+        struct Loop
+        {
+            const std::function<void(std::size_t)>& task;
+            const std::size_t           count;
+            std::atomic<std::size_t>    next{ 0 };
+            std::atomic<bool>           failed{ false };
+            std::mutex                  mutex{};
+            std::exception_ptr          error{ nullptr };
+        };
+
+        std::vector<std::thread>    mWorkers{};
+        std::mutex                  mMutex{};
+        std::condition_variable     mWake{};
+        std::condition_variable     mDone{};
+        Loop*                       mLoop{ nullptr };
+        std::uint64_t               mGeneration{ 0 };
+        std::size_t                 mFinished{ 0 };
+        std::atomic<bool>           mBusy{ false };
+        bool                        mStop{ false };
+
+        static void work(Loop& loop) noexcept
+        {
+            for (auto i = loop.next.fetch_add(1); i < loop.count && !loop.failed; i = loop.next.fetch_add(1)) {
+                try {
+                    loop.task(i);
+                }
+                catch (...) {
+                    std::lock_guard lock{ loop.mutex };
+                    if (!loop.error)
+                        loop.error = std::current_exception();
+                    loop.failed = true;
+                }
+            }
+        }
+
+        void run()
+        {
+            std::uint64_t generation{ 0 };
+            for (;;) {
+                Loop* loop{ nullptr };
+                {
+                    std::unique_lock lock{ mMutex };
+                    mWake.wait(lock, [&] { return mStop || mGeneration != generation; });
+                    if (mStop)
+                        return;
+                    generation = mGeneration;
+                    loop = mLoop;
+                }
+                work(*loop);
+                {
+                    std::lock_guard lock{ mMutex };
+                    ++mFinished;
+                }
+                mDone.notify_one();
+            }
+        }
+    };
+}
+
+#endif	// INC_TaskPool_H
+// end of TaskPool.h
+///---------------------------------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+///---------------------------------------------------------------------------------------------------
+// file:		Tee_OutputArchive.h
+//
+// summary: 	Declares the tee output archive class
+//
+// Copyright (c) 2026 Alexander Neumann.
+//
+// author: Alexander
+// date: 17.10.2026
+#pragma once
+#ifndef INC_Tee_OutputArchive_H
+#define INC_Tee_OutputArchive_H
+///---------------------------------------------------------------------------------------------------
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include <SerAr/Core/NamedValue.h>
+#include <SerAr/Core/OutputArchive.h>
+
+namespace SerAr
+{
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Archives which can open and close a named group (struct) explicitly.
+    /// 			beginGroup(name) must do the same as saving a NamedValue holding a struct before
+    /// 			the first member; endGroup() the same after the last member. The name stays valid
+    /// 			until endGroup() is called. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename Archive>
+    concept HasGroupInterface = requires(Archive& ar, std::string_view name) {
+        ar.beginGroup(name);
+        ar.endGroup();
+    };
+}
+
+namespace Archives
+{
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Output archive writing everything into several other output archives.
+    ///
+    /// 			If all backends implement HasGroupInterface, named user types are traversed only once:
+    /// 			The tee opens a group in every backend and calls serialize/save of the type with
+    /// 			itself, so every member is converted and forwarded in the same pass. Everything else
+    /// 			(arithmetic values, strings, containers, ...) is forwarded to the backends as is.
+    /// 			The backends are not owned and must outlive the tee. </summary>
+    ///
+    /// <typeparam name="Backends"> Types of the output archives written to. </typeparam>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename... Backends>
+    class Tee_OutputArchive : public OutputArchive<Tee_OutputArchive<Backends...>>
+    {
+        static_assert(sizeof...(Backends) > 0, "Tee_OutputArchive requires at least one backend!");
+        static_assert((IsOutputArchive<Backends> && ...), "All backends of a Tee_OutputArchive must be output archives!");
+
+        using ThisClass = Tee_OutputArchive<Backends...>;
+
+        // User types are traversed by the tee itself if all backends can open groups
+        template<typename T>
+        static constexpr bool traverse_once = IsTypeSaveable<std::remove_cvref_t<T>, ThisClass> && (HasGroupInterface<Backends> && ...);
+    public:
+        explicit Tee_OutputArchive(Backends&... backends) : OutputArchive<ThisClass>(this), mBackends(backends...) {}
+
+        DISALLOW_COPY_AND_ASSIGN(Tee_OutputArchive)
+
+        // Named user types: one traversal for all backends
+        template<typename T> requires (traverse_once<T>)
+        inline void save(const NamedValue<T>& value)
+        {
+            const std::string_view name{ value.getName() };
+            std::apply([name](auto&... backend) { (backend.beginGroup(name), ...); }, mBackends);
+            this->operator()(value.getValue());
+            std::apply([](auto&... backend) { (backend.endGroup(), ...); }, mBackends);
+        }
+
+        // Everything else is written by every backend itself
+        template<typename T> requires (!traverse_once<T>)
+        inline void save(const T& value)
+        {
+            std::apply([&value](auto&... backend) { (backend(value), ...); }, mBackends);
+        }
+
+        template<std::size_t I>
+        inline auto& getBackend() noexcept { return std::get<I>(mBackends); }
+    private:
+        std::tuple<Backends&...> mBackends;
+    };
+}
+
+#endif	// INC_Tee_OutputArchive_H
+// end of Tee_OutputArchive.h
+///---------------------------------------------------------------------------------------------------
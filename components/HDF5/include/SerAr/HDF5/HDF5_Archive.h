@@ -14,12 +14,16 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 
 #include <type_traits>
 
 #include <filesystem>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <functional>
 #include <numeric>
 
@@ -32,16 +36,23 @@
 #include <complex>
 #include <exception>
 #include <memory>
+#include <optional>
+#include <span>
 #include <stack>
+#include <memory_resource>
 #include <hdf5.h>
 
 #include <MyCEL/basics/BasicMacros.h>
 #include <MyCEL/basics/BasicIncludes.h>
 #include <MyCEL/stdext/std_extensions.h>
 
+#include <SerAr/Core/ArchiveMemoryResource.h>
+#include <SerAr/Core/ArrayView.h>
 #include <SerAr/Core/NamedValue.h>
+#include <SerAr/Core/Deferred.h>
 #include <SerAr/Core/InputArchive.h>
 #include <SerAr/Core/OutputArchive.h>
+#include <SerAr/Core/SizeEstimate_OutputArchive.h>
 
 #include "HDF5_Wrappers.h"
 
@@ -111,6 +122,90 @@ namespace Archives
         {
 
         }
+
+        //Column-major (Eigen) matrices are stored as they are in memory with swapped dimensions; the attribute marks such datasets
+        static constexpr const char* ColumnMajorAttribute = "ColumnMajor";
+
+        static void setColumnMajor(hid_t dataset, bool columnmajor)
+        {
+            if ((H5Aexists(dataset, ColumnMajorAttribute) > 0) == columnmajor)
+                return;
+            if (!columnmajor) // A reused dataset may still carry the attribute
+            {
+                if (H5Adelete(dataset, ColumnMajorAttribute) < 0)
+                    throw std::runtime_error{ "Unable to remove the column-major attribute of a HDF5 dataset!" };
+                return;
+            }
+            const hid_t space = H5Screate(H5S_SCALAR);
+            const hid_t attribute = H5Acreate2(dataset, ColumnMajorAttribute, H5T_STD_U8LE, space, H5P_DEFAULT, H5P_DEFAULT);
+            const std::uint8_t value{ 1 };
+            const herr_t err = attribute < 0 ? attribute : H5Awrite(attribute, H5T_NATIVE_UINT8, &value);
+            if (attribute >= 0)
+                H5Aclose(attribute);
+            H5Sclose(space);
+            if (err < 0)
+                throw std::runtime_error{ "Unable to mark a HDF5 dataset as column-major!" };
+        }
+
+        static bool isColumnMajor(hid_t dataset)
+        {
+            if (H5Aexists(dataset, ColumnMajorAttribute) <= 0)
+                return false;
+            std::uint8_t value{ 0 };
+            const hid_t attribute = H5Aopen(dataset, ColumnMajorAttribute, H5P_DEFAULT);
+            const herr_t err = attribute < 0 ? attribute : H5Aread(attribute, H5T_NATIVE_UINT8, &value);
+            if (attribute >= 0)
+                H5Aclose(attribute);
+            if (err < 0)
+                throw std::runtime_error{ "Unable to read the column-major attribute of a HDF5 dataset!" };
+            return value != 0;
+        }
+    };
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Buffer to stage the elements of non-contiguous containers (std::list, std::deque,
+    /// 			std::set, ...) so that they can be transferred with one HDF5 call per chunk.
+    /// 			The memory is kept and reused by all following transfers of the archive. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    class HDF5_StagingBuffer
+    {
+    public:
+        HDF5_StagingBuffer(std::pmr::memory_resource* resource, std::size_t maxbytes) noexcept : mResource(resource), mMaxBytes(maxbytes) {}
+        DISALLOW_COPY_AND_ASSIGN(HDF5_StagingBuffer)
+        ~HDF5_StagingBuffer() { release(); }
+
+        // Number of elements transferred at once for a container with the given number of elements
+        template<typename T>
+        std::size_t chunkSize(std::size_t elements) const noexcept
+        {
+            return std::min(elements, std::max<std::size_t>(mMaxBytes / sizeof(T), 1));
+        }
+
+        template<typename T>
+        std::span<T> get(std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= alignof(std::max_align_t));
+            if (count * sizeof(T) > mBytes) {
+                release();
+                mData = mResource->allocate(count * sizeof(T), alignof(std::max_align_t));
+                mBytes = count * sizeof(T);
+            }
+            return { static_cast<T*>(mData), count };
+        }
+
+    private:
+        void release() noexcept
+        {
+            if (mData != nullptr)
+                mResource->deallocate(mData, mBytes, alignof(std::max_align_t));
+            mData = nullptr;
+            mBytes = 0;
+        }
+
+        std::pmr::memory_resource* mResource;
+        std::size_t mMaxBytes;
+        void* mData{ nullptr };
+        std::size_t mBytes{ 0 };
     };
 
 
@@ -134,8 +229,46 @@ namespace Archives
         HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode FileCreationMode{ HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode::CreateOrOverwrite };
         HDF5_Wrapper::HDF5_DatatypeOptions			 DefaultDatatypeOptions{};
         HDF5_Wrapper::HDF5_DataspaceOptions			 DefaultDataspaceOptions{};
+        HDF5_Wrapper::HDF5_DatasetLayoutOptions		 DefaultDatasetLayoutOptions{};	// Chunking and compression of all datasets (see HDF5_NamedValueWithLayout)
+        bool										 FixedLengthStrings{ false };	// Containers of strings are padded to the longest string instead of stored with variable length
+        std::size_t									 StagingBufferBytes{ 1024 * 1024 };	// Non-contiguous containers are written in chunks of this size
+        std::size_t									 AppendBufferRecords{ 256 };	// Records buffered per dataset by HDF5_OutputArchive::append before they are written
+        std::pmr::memory_resource*					 MemoryResource{ nullptr };	// Group stack and paths; nullptr = arena owned by the archive
+        std::size_t									 MetadataBlockBytes{ 0 };	// Object headers are allocated from blocks of this size; 0 = HDF5 default (2 KiB)
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Sizes the metadata blocks from a dry run (SizeEstimate_OutputArchive) of the values to
+        /// 			be written, so that the headers of all groups and datasets are allocated together
+        /// 			instead of interleaved with the raw data in many small blocks. </summary>
+        ///-------------------------------------------------------------------------------------------------
+        void useSizeEstimate(const SizeEstimate& estimate) noexcept
+        {
+            // Rough upper bounds of an object header including its link in the parent group;
+            // groups additionally need their symbol table (B-tree and local heap)
+            constexpr std::size_t datasetBytes{ 512 }, groupBytes{ 1024 }, minBlock{ 2048 }, maxBlock{ 16 * 1024 * 1024 };
+            const auto bytes = estimate.datasets * datasetBytes + estimate.groups * groupBytes + estimate.name_bytes;
+            MetadataBlockBytes = std::clamp(bytes, minBlock, maxBlock);
+        }
+    };
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	NamedValue whose datasets (including the ones of nested values) are created with their
+    /// 			own chunking and filters instead of HDF5_OutputOptions::DefaultDatasetLayoutOptions.
+    /// 			The input archive loads it like the plain NamedValue. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    template<typename T>
+    struct HDF5_NamedValueWithLayout
+    {
+        NamedValue<T> value;
+        HDF5_Wrapper::HDF5_DatasetLayoutOptions layout;
     };
 
+    template<typename T>
+    inline HDF5_NamedValueWithLayout<T> createNamedValueWithLayout(NamedValueName name, T&& value, HDF5_Wrapper::HDF5_DatasetLayoutOptions layout)
+    {
+        return HDF5_NamedValueWithLayout<T>{ createNamedValue(std::move(name), std::forward<T>(value)), std::move(layout) };
+    }
+
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	HDF5 output archive. </summary>
     ///
@@ -148,12 +281,22 @@ namespace Archives
         using Options = HDF5_OutputOptions;
        
         HDF5_OutputArchive(const std::filesystem::path &path, const HDF5_OutputOptions& options = HDF5_OutputOptions{})
-            : OutputArchive(this), mFile(openOrCreateFile(path, options)), mOptions(options) {
+            : OutputArchive(this), mFile(openOrCreateFile(path, options)), mMemory(options.MemoryResource), mOptions(options), mLayout(options.DefaultDatasetLayoutOptions) {
             static_assert(std::is_same_v<ThisClass, std::decay_t<decltype(*this)>>);
         };
 
         DISALLOW_COPY_AND_ASSIGN(HDF5_OutputArchive)
 
+        // Records still buffered by append are written; errors can only be noticed by calling flush before
+        ~HDF5_OutputArchive() noexcept
+        {
+            try {
+                writeAppendBuffers();
+            }
+            catch (...) { // Destructors must not throw
+            }
+        }
+
         template<typename T>
         inline void save(const Archives::NamedValue<T>& value)
         {
@@ -162,6 +305,27 @@ namespace Archives
             clearNextPath();					//Remove the Last Fieldname
         };
 
+        //Views (std::span/std::mdspan) are written directly from the viewed memory; the dataspace has the extents of the view
+        template<typename T> requires (SerAr::IsArrayView<std::remove_cvref_t<T>>)
+        inline void save(const Archives::NamedValue<T>& value)
+        {
+            setNextPath(value.getName());
+            writeArrayView(arrayViewData(value.getValue()), arrayViewExtents(value.getValue()));
+            clearNextPath();
+        };
+
+        //Datasets below the value are created with the layout of the value; the previous layout is restored afterwards
+        template<typename T>
+        inline void save(const HDF5_NamedValueWithLayout<T>& value)
+        {
+            struct RestoreLayout {
+                HDF5_Wrapper::HDF5_DatasetLayoutOptions& current;
+                HDF5_Wrapper::HDF5_DatasetLayoutOptions previous;
+                ~RestoreLayout() { current = std::move(previous); }
+            } restore{ mLayout, std::exchange(mLayout, value.layout) };
+            this->operator()(value.value);
+        };
+
         template<typename T>
         inline std::enable_if_t< HDF5_traits::has_write_to_HDF5<std::decay_t<T>>::value > save(const T& value)
         {
@@ -188,44 +352,162 @@ namespace Archives
             closeLastGroup(value);
         };
 
+        // Group interface (see SerAr::HasGroupInterface); same as the prologue/epilogue of a nested struct
+        inline void beginGroup(std::string_view name)
+        {
+            setNextPath(name);
+            createOrOpenGroup(name);
+            clearNextPath();
+        }
+        inline void endGroup()
+        {
+            popGroup();
+        }
+
+        // Writes all buffered data of the file to disk
+        inline void flush()
+        {
+            writeAppendBuffers();
+            if (H5Fflush(mFile, H5F_SCOPE_GLOBAL) < 0)
+                throw std::runtime_error{ "Unable to flush HDF5 file!" };
+        }
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Appends a record (arithmetic value, contiguous container or view) to a dataset in the
+        /// 			current group. The dataset gets an unlimited leading dimension and is chunked; it is
+        /// 			created on first use or continued if it already exists. Records are buffered and
+        /// 			written AppendBufferRecords at a time (see HDF5_OutputOptions) or on flush. All
+        /// 			records of a dataset must have the same element type and size. </summary>
+        ///-------------------------------------------------------------------------------------------------
+        template<typename T>
+        void append(const Archives::NamedValue<T>& value)
+        {
+            using Type = std::remove_cvref_t<T>;
+            const auto& val = value.getValue();
+            if constexpr (std::is_arithmetic_v<Type> || stdext::is_complex_v<Type>)
+                appendRecord(value.getName(), std::span<const Type, 1>{ &val, 1 }, std::array<std::size_t, 0>{});
+            else if constexpr (SerAr::IsArrayView<Type>)
+                appendRecord(value.getName(), arrayViewData(val), arrayViewExtents(val));
+            else
+            {
+                static_assert(stdext::is_memory_sequentiel_container_v<Type> && (std::is_arithmetic_v<typename Type::value_type> || stdext::is_complex_v<typename Type::value_type>),
+                              "Only arithmetic values, contiguous containers and views of them can be appended!");
+                appendRecord(value.getName(), std::span<const typename Type::value_type>{ val.data(), val.size() }, std::array<std::size_t, 1>{ val.size() });
+            }
+        }
+        template<typename T>
+        void append(const HDF5_NamedValueWithLayout<T>& value)
+        {
+            struct RestoreLayout {
+                HDF5_Wrapper::HDF5_DatasetLayoutOptions& current;
+                HDF5_Wrapper::HDF5_DatasetLayoutOptions previous;
+                ~RestoreLayout() { current = std::move(previous); }
+            } restore{ mLayout, std::exchange(mLayout, value.layout) };
+            append(value.value);
+        }
+
+        // Shared objects (see SerAr::HasSharedObjectSave); later occurrences become hard links to the first one
+        inline ObjectTracker& objectTracker() noexcept { return mObjects; }
+        std::string objectLocation(std::string_view name) const
+        {
+            if (name.empty())
+                throw std::runtime_error{ "HDF5 archives can only store named shared objects!" };
+            const HDF5_Wrapper::HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_Wrapper::HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
+            auto location = currentLoc.getHDF5Path();
+            if (location.empty() || location.back() != '/')
+                location.push_back('/');
+            location.append(name);
+            return location;
+        }
+        void saveObjectReference(std::string_view name, const std::string& location)
+        {
+            const HDF5_Wrapper::HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_Wrapper::HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
+            const std::string link{ name };
+            if (H5Lexists(currentLoc, link.c_str(), H5P_DEFAULT) > 0) // Replace a previously written value
+                H5Ldelete(currentLoc, link.c_str(), H5P_DEFAULT);
+            if (H5Lcreate_hard(mFile, location.c_str(), currentLoc, link.c_str(), H5P_DEFAULT, H5P_DEFAULT) < 0)
+                throw std::runtime_error{ "Unable to create HDF5 hard link '" + link + "' to '" + location + "'!" };
+        }
+
     private:
         
         using CurrentGroup = HDF5_Wrapper::HDF5_GroupWrapper;
         using File = HDF5_Wrapper::HDF5_FileWrapper;
         
         File mFile;
-        std::stack<CurrentGroup> mGroupStack;
-        std::string nextPath;
+        ArchiveMemoryResource mMemory;
+        pmr_stack<CurrentGroup> mGroupStack{ mMemory.get() };
+        std::pmr::string nextPath{ mMemory.get() };
         HDF5_OutputOptions mOptions;
+        HDF5_Wrapper::HDF5_DatasetLayoutOptions mLayout;	//Layout of the next created datasets
+        HDF5_StagingBuffer mStaging{ mMemory.get(), mOptions.StagingBufferBytes };
+        ObjectTracker mObjects{};
+
+        //Open extendible dataset with the records not yet written
+        struct AppendBuffer
+        {
+            HDF5_Wrapper::HDF5_DatasetWrapper dataset;
+            HDF5_Wrapper::HDF5_DatatypeWrapper memorytype;
+            const void* recordtype;					//Type tag of the element type of the records (see appendTypeTag)
+            std::vector<std::size_t> recorddims;	//Dimensions of a single record
+            std::size_t recordbytes;
+            std::size_t written;					//Records in the dataset
+            std::size_t buffered{ 0 };
+            std::vector<std::byte> data{};			//Space for AppendBufferRecords records
+        };
+        template<typename T>
+        static constexpr char appendTypeTag{};		//Only the address is used; unique per type
+        std::map<std::string, AppendBuffer, std::less<>> mAppendBuffers;	//Keyed by the absolute dataset path
+        std::map<std::string, AppendBuffer*, std::less<>> mAppendLookup;	//Keyed by mGroupPath + '/' + name; avoids asking HDF5 for the path on every append
+        std::pmr::string mGroupPath{ mMemory.get() };						//Names of the open groups separated by '/'
+        pmr_stack<std::size_t> mGroupPathLengths{ mMemory.get() };			//Length of mGroupPath before each open group
         static File openOrCreateFile(const std::filesystem::path &path, const HDF5_OutputOptions& options)
         {
             using namespace HDF5_Wrapper;
             HDF5_FileOptions opt{};
             opt.mode = options.FileCreationMode;
-            
+
+            //Metadata block size (see HDF5_OutputOptions::useSizeEstimate)
+            struct PropertyList {
+                hid_t id{ H5P_DEFAULT };
+                ~PropertyList() { if (id > 0 && id != H5P_DEFAULT) H5Pclose(id); }
+            } access{};
+            if (options.MetadataBlockBytes > 0) {
+                access.id = H5Pcreate(H5P_FILE_ACCESS);
+                if (access.id < 0 || H5Pset_meta_block_size(access.id, options.MetadataBlockBytes) < 0)
+                    throw std::runtime_error{ "Unable to set up the HDF5 file access property list!" };
+                opt.access_propertylist = access.id;
+            }
+
             File file{ path, opt };
             return file; 
             //return file; //this called a destructor!
         }
 
-        bool isValidNextLocation(const std::string&) const
+        bool isValidNextLocation(std::string_view) const
         {
             //TODO: Check the Location name for invalid characters
             return true;
         }
-        void setNextPath(const std::string& str)
+        void setNextPath(std::string_view str)
         {
             if (!isValidNextLocation(str))
                 throw std::runtime_error{ "Invalid HDF5 path string!" };
 
             assert(nextPath.empty());
             
-            nextPath = str;
+            nextPath.assign(str); // reuses the capacity of nextPath; no allocation per field
         }
         void clearNextPath()
         {
             nextPath.clear();
         }
+        HDF5_Wrapper::HDF5_DatasetOptions datasetOptions() const
+        {
+            HDF5_Wrapper::HDF5_DatasetOptions opts;
+            opts.layout = mLayout;
+            return opts;
+        }
 
         template<typename T>
         void createOrOpenGroup(const T&)
@@ -239,13 +521,146 @@ namespace Archives
             opts.mode = HDF5_GeneralOptions::HDF5_Mode::OpenOrCreate;
             HDF5_GroupWrapper group(currentLoc, nextPath, opts );
             mGroupStack.push(std::move(group));
+            mGroupPathLengths.push(mGroupPath.size());
+            mGroupPath.append("/").append(nextPath);
         }
 
         template<typename T>
         void closeLastGroup(const T&)
+        {
+            popGroup();
+        }
+
+        void popGroup()
         {
             assert(!mGroupStack.empty());
             mGroupStack.pop();
+            mGroupPath.resize(mGroupPathLengths.top());
+            mGroupPathLengths.pop();
+        }
+
+        template<typename T, std::size_t Extent, std::size_t Rank>
+        void appendRecord(std::string_view name, std::span<T, Extent> record, const std::array<std::size_t, Rank>& extents)
+        {
+            using DataType = std::remove_cv_t<T>;
+            auto& buffer = getAppendBuffer<DataType>(name, extents);
+            if (buffer.recordtype != &appendTypeTag<DataType> || record.size_bytes() != buffer.recordbytes || !std::ranges::equal(extents, buffer.recorddims))
+                throw std::runtime_error{ "Record appended to '" + std::string{ name } + "' does not match the type or size of the previous records!" };
+
+            std::memcpy(buffer.data.data() + buffer.buffered * buffer.recordbytes, record.data(), buffer.recordbytes);
+            if (++buffer.buffered >= std::max<std::size_t>(mOptions.AppendBufferRecords, 1))
+                writeAppendBuffer(buffer);
+        }
+
+        template<typename DataType, std::size_t Rank>
+        AppendBuffer& getAppendBuffer(std::string_view name, const std::array<std::size_t, Rank>& extents)
+        {
+            const auto groupPathLength = mGroupPath.size();
+            mGroupPath.append("/").append(name);
+            if (const auto cached = mAppendLookup.find(std::string_view{ mGroupPath }); cached != mAppendLookup.end())
+            {
+                mGroupPath.resize(groupPathLength);
+                return *cached->second;
+            }
+            std::string key{ mGroupPath };
+            mGroupPath.resize(groupPathLength);
+
+            HDF5_Wrapper::HDF5_DatatypeWrapper memorytype(DataType{}, mOptions.DefaultDatatypeOptions);
+            auto& buffer = openAppendBuffer(name, memorytype, &appendTypeTag<DataType>, std::vector<std::size_t>(extents.begin(), extents.end()));
+            mAppendLookup.emplace(std::move(key), &buffer);
+            return buffer;
+        }
+
+        //Buffer of the dataset; different (group, name) pairs may refer to the same dataset
+        AppendBuffer& openAppendBuffer(std::string_view name, const HDF5_Wrapper::HDF5_DatatypeWrapper& memorytype, const void* recordtype, std::vector<std::size_t> recorddims)
+        {
+            using namespace HDF5_Wrapper;
+
+            auto location = objectLocation(name);
+            if (const auto found = mAppendBuffers.find(location); found != mAppendBuffers.end())
+                return found->second;
+
+            const HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
+            const std::string path{ name };
+            auto datasetopts{ datasetOptions() };
+            std::size_t written{ 0 };
+            std::optional<HDF5_DatasetWrapper> dataset;
+            if (H5Lexists(currentLoc, path.c_str(), H5P_DEFAULT) > 0)
+            {
+                //Continue an extendible dataset with the same record dimensions
+                const auto notAppendable = [&location]() { return std::runtime_error{ "HDF5 object '" + location + "' exists but records of the given size cannot be appended to it!" }; };
+                const hid_t object = H5Oopen(currentLoc, path.c_str(), H5P_DEFAULT);
+                const bool isDataset = object >= 0 && H5Iget_type(object) == H5I_DATASET;
+                if (object >= 0)
+                    H5Oclose(object);
+                if (!isDataset)
+                    throw notAppendable();
+                datasetopts.mode = HDF5_GeneralOptions::HDF5_Mode::Open;
+                dataset.emplace(currentLoc, path, datasetopts);
+                const auto space = dataset->getDataspace();
+                const auto rank = H5Sget_simple_extent_ndims(space);
+                std::vector<hsize_t> dims(static_cast<std::size_t>(std::max(rank, 0))), maxdims(dims.size());
+                H5Sget_simple_extent_dims(space, dims.data(), maxdims.data());
+                if (dims.size() != recorddims.size() + 1 || maxdims[0] != H5S_UNLIMITED || !std::equal(recorddims.begin(), recorddims.end(), dims.begin() + 1))
+                    throw notAppendable();
+                written = dims[0];
+            }
+            else
+            {
+                HDF5_DataspaceOptions dataspaceopts;
+                dataspaceopts.dims.assign(1, 0);
+                dataspaceopts.dims.insert(dataspaceopts.dims.end(), recorddims.begin(), recorddims.end());
+                dataspaceopts.maxdims = dataspaceopts.dims;
+                dataspaceopts.maxdims[0] = H5S_UNLIMITED;
+                if (datasetopts.layout.chunking == HDF5_DatasetLayoutOptions::HDF5_Chunking::None) // Extendible datasets must be chunked
+                    datasetopts.layout.chunking = HDF5_DatasetLayoutOptions::HDF5_Chunking::Auto;
+
+                HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(memorytype), HDF5_DataspaceWrapper(H5S_SIMPLE, dataspaceopts) };
+                dataset.emplace(currentLoc, path, std::move(storeopts), datasetopts);
+            }
+
+            const auto recordbytes = std::accumulate(recorddims.begin(), recorddims.end(), memorytype.getSize(), std::multiplies<std::size_t>());
+            auto [inserted, _] = mAppendBuffers.try_emplace(std::move(location), AppendBuffer{ std::move(*dataset), memorytype, recordtype, std::move(recorddims), recordbytes, written });
+            inserted->second.data.resize(recordbytes * std::max<std::size_t>(mOptions.AppendBufferRecords, 1));
+            return inserted->second;
+        }
+
+        //Extends the dataset by the buffered records and writes them with a single hyperslab
+        void writeAppendBuffer(AppendBuffer& buffer)
+        {
+            using namespace HDF5_Wrapper;
+
+            if (buffer.buffered == 0)
+                return;
+
+            std::vector<std::size_t> dims{ buffer.written + buffer.buffered };
+            dims.insert(dims.end(), buffer.recorddims.begin(), buffer.recorddims.end());
+            const std::vector<hsize_t> extent(dims.begin(), dims.end());
+            if (H5Dset_extent(buffer.dataset, extent.data()) < 0)
+                throw std::runtime_error{ "Unable to extend HDF5 dataset!" };
+
+            std::vector<std::size_t> start(dims.size(), 0);
+            start[0] = buffer.written;
+            dims[0] = buffer.buffered;
+            const std::vector<std::size_t> ones(dims.size(), 1);
+            auto storespace = buffer.dataset.getDataspace();
+            storespace.selectSlab(H5S_SELECT_SET, start, ones, dims, ones);
+
+            HDF5_DataspaceOptions memoryspaceopt;
+            memoryspaceopt.dims.assign(dims.begin(), dims.end());
+            memoryspaceopt.maxdims = memoryspaceopt.dims;
+            HDF5_MemoryOptions memoryopts{ buffer.memorytype, HDF5_DataspaceWrapper(H5S_SIMPLE, memoryspaceopt) };
+            if (buffer.dataset.writeBuffer(buffer.data.data(), memoryopts, storespace) < 0)
+                throw std::runtime_error{ "Unable to append to HDF5 dataset!" };
+
+            buffer.written += buffer.buffered;
+            buffer.buffered = 0;
+        }
+
+        void writeAppendBuffers()
+        {
+            for (auto& [location, buffer] : mAppendBuffers)
+                writeAppendBuffer(buffer);
         }
         
         public: // For some reason the write functions must be public for clang to detect that the class can use them.
@@ -261,7 +676,7 @@ namespace Archives
             const auto dataspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
             const HDF5_DataspaceOptions dataspaceopts;
             HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(val, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
-            HDF5_DatasetOptions datasetopts;
+            HDF5_DatasetOptions datasetopts{ datasetOptions() };
             HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
 
             //Creating the Memory space
@@ -286,7 +701,7 @@ namespace Archives
             const auto dataspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
             const HDF5_DataspaceOptions dataspaceopts;
             HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(val, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
-            HDF5_DatasetOptions datasetopts;
+            HDF5_DatasetOptions datasetopts{ datasetOptions() };
             HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
 
             //Creating the Memory space
@@ -309,6 +724,8 @@ namespace Archives
 
             if constexpr (stdext::is_memory_sequentiel_container_v<std::decay_t<T>>)
             {
+                using DataType = std::remove_cv_t<typename std::decay_t<T>::value_type>;
+
                 //Creating the dataset! 
                 const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
                 const auto dataspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
@@ -318,8 +735,8 @@ namespace Archives
                 dataspaceopts.dims = std::vector<hsize_t>{ { val.size() } };
                 dataspaceopts.maxdims = dataspaceopts.dims;
 
-                HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(*val.begin(), datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
-                HDF5_DatasetOptions datasetopts;
+                HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(DataType{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+                HDF5_DatasetOptions datasetopts{ datasetOptions() };
                 HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
 
                 //Creating the storage dataspace selection (default is enough -> All space)
@@ -333,12 +750,15 @@ namespace Archives
                 memoryspaceopt.dims = std::vector<hsize_t>{ { val.size() } };
                 memoryspaceopt.maxdims = memoryspaceopt.dims;
 
-                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(val[0], memorytypeopts), HDF5_DataspaceWrapper(memoryspacetype, memoryspaceopt) };
+                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(DataType{}, memorytypeopts), HDF5_DataspaceWrapper(memoryspacetype, memoryspaceopt) };
 
                 dataset.writeData(val, memoryopts);
             }
-            else if constexpr (!stdext::is_associative_container_v<std::decay_t<T>>)
+            else
             {
+                //Non-contiguous containers (e.g. std::list, std::deque, std::set) are gathered into the staging buffer and written chunk by chunk
+                using DataType = std::remove_cv_t<typename std::decay_t<T>::value_type>;
+
                 //Creating the dataset! 
                 const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
                 const auto dataspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
@@ -348,34 +768,54 @@ namespace Archives
                 dataspaceopts.dims = std::vector<hsize_t>{ { val.size() } };
                 dataspaceopts.maxdims = dataspaceopts.dims;
 
-                HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(*val.begin(), datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
-                HDF5_DatasetOptions datasetopts;
+                HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(DataType{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+                HDF5_DatasetOptions datasetopts{ datasetOptions() };
                 HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
-            
-                //Creating the storage dataspace selection
-                HDF5_DataspaceWrapper stordataspace(dataspacetype, dataspaceopts);
-                stordataspace.removeSelection();
-                stordataspace.selectSlab(H5S_SELECT_SET, { 0 }, { 1 }, { 1 }, { 1 });
-
-                //Creating the memory space
-                const auto memoryspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
-                const auto memorytypeopts{ mOptions.DefaultDatatypeOptions };
-                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(val[0], memorytypeopts), stordataspace };
 
-                std::vector<std::int64_t> offset{ { 0 } };
-                for (const auto& str : val)
+                HDF5_DataspaceWrapper stordataspace(dataspacetype, dataspaceopts);
+                const auto chunk = mStaging.chunkSize<DataType>(val.size());
+                const auto buffer = mStaging.get<DataType>(chunk);
+                auto elem = val.begin();
+                for (std::size_t offset = 0; offset < val.size(); offset += chunk)
                 {
-                    dataset.writeData(str, memoryopts, stordataspace);
-                    ++(offset[0]);
-                    stordataspace.setOffset(offset);
+                    const auto count = std::min(chunk, val.size() - offset);
+                    for (std::size_t i = 0; i < count; ++i, ++elem)
+                        buffer[i] = *elem;
+
+                    stordataspace.selectSlab(H5S_SELECT_SET, { offset }, { 1 }, { count }, { 1 });
+                    HDF5_DataspaceOptions memoryspaceopt;
+                    memoryspaceopt.dims = std::vector<hsize_t>{ { count } };
+                    memoryspaceopt.maxdims = memoryspaceopt.dims;
+                    HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(DataType{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, memoryspaceopt) };
+                    if (dataset.writeBuffer(buffer.data(), memoryopts, stordataspace) < 0)
+                        throw std::runtime_error{ "Unable to write HDF5 dataset '" + std::string{ nextPath } + "'!" };
                 }
             }
-            else
-            {
-                static_assert(!stdext::is_memory_sequentiel_container_v<std::decay_t<T>>, "Case not implemented yet! Please implement it!");
-                //How to do it: For sequentiell containers: Write elements one at a time in a for loop into the dataset. Needs selection of appropiate dataspaces!
-                // For associative containers: Open 
-            }
+        }
+
+        template <typename T, std::size_t Rank>
+        void writeArrayView(std::span<T> data, const std::array<std::size_t, Rank>& extents)
+        {
+            using namespace HDF5_Wrapper;
+            using DataType = std::remove_cv_t<T>;
+
+            const HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
+
+            //Creating the dataset with the extents of the view
+            const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
+            const auto dataspacetype = Rank == 0 ? H5S_SCALAR : H5S_SIMPLE;
+            HDF5_DataspaceOptions dataspaceopts;
+            dataspaceopts.dims.assign(extents.begin(), extents.end());
+            dataspaceopts.maxdims = dataspaceopts.dims;
+
+            HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(DataType{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+            HDF5_DatasetOptions datasetopts{ datasetOptions() };
+            HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
+
+            //The memory space describes the viewed buffer itself; no copy is made
+            HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(DataType{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+            if (!data.empty() && dataset.writeBuffer(data.data(), memoryopts) < 0)
+                throw std::runtime_error{ "Unable to write HDF5 dataset '" + std::string{ nextPath } + "'!" };
         }
 
         template <typename T>
@@ -385,43 +825,66 @@ namespace Archives
 
                 const HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
 
-                //Creating the dataset! 
-                const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
-                const auto dataspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
-
                 //Settings storage dimensions
+                const auto dataspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
                 HDF5_DataspaceOptions dataspaceopts;
                 dataspaceopts.dims = std::vector<hsize_t>{ { val.size() } };
                 dataspaceopts.maxdims = std::vector<hsize_t>{ { val.size() } };
 
-                HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(*val.begin(), datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
-                HDF5_DatasetOptions datasetopts;
-                HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
-                
-                //Creating the storage dataspace selection
-                HDF5_DataspaceWrapper stordataspace(dataspacetype, dataspaceopts);
-                stordataspace.removeSelection();
-                stordataspace.selectSlab(H5S_SELECT_SET, { 0 }, { 1 }, { 1 }, { 1 });
-
-                //Creating the memory space
-                const auto memoryspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
-                const auto memorytypeopts{ mOptions.DefaultDatatypeOptions };
-                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(val[0], memorytypeopts), stordataspace };
+                //All strings are written with a single call: either packed into one buffer of fixed-length strings
+                //or as an array of pointers for variable-length strings
+                if (mOptions.FixedLengthStrings)
+                {
+                    std::size_t length{ 1 }; // HDF5 does not allow strings of size 0
+                    for (const auto& str : val)
+                        length = std::max(length, str.size());
+                    HDF5_DatatypeWrapper type{ HDF5_LocationWrapper(H5Tcopy(H5T_C_S1)) };
+                    H5Tset_size(type, length);
+                    H5Tset_strpad(type, H5T_STR_NULLPAD);
+
+                    std::string packed(val.size() * length, '\0');
+                    auto position = packed.begin();
+                    for (const auto& str : val)
+                    {
+                        std::copy(str.begin(), str.end(), position);
+                        position += static_cast<std::ptrdiff_t>(length);
+                    }
 
-                std::vector<std::int64_t> offset{ {0} };
-                for (const auto& str : val)
+                    HDF5_StorageOptions storeopts{ type, HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+                    HDF5_DatasetOptions datasetopts{ datasetOptions() };
+                    HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
+                    HDF5_MemoryOptions memoryopts{ type, HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+                    if (!packed.empty() && dataset.writeBuffer(packed.data(), memoryopts) < 0)
+                        throw std::runtime_error{ "Unable to write HDF5 dataset '" + std::string{ nextPath } + "'!" };
+                }
+                else
                 {
-                    dataset.writeData(str.c_str(), memoryopts, stordataspace);
-                    ++(offset[0]);
-                    stordataspace.setOffset(offset);
-                }	
+                    std::vector<const char*> strings;
+                    strings.reserve(val.size());
+                    for (const auto& str : val)
+                        strings.push_back(str.c_str());
+
+                    const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
+                    HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(std::string{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+                    HDF5_DatasetOptions datasetopts{ datasetOptions() };
+                    HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
+                    HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(std::string{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+                    if (!strings.empty() && dataset.writeBuffer(strings.data(), memoryopts) < 0)
+                        throw std::runtime_error{ "Unable to write HDF5 dataset '" + std::string{ nextPath } + "'!" };
+                }
         }
 #ifdef EIGEN_CORE_H
         template <typename T>
         std::enable_if_t<stdext::is_eigen_type_v<std::decay_t<T>>> write(const T& val)
         {
             using namespace HDF5_Wrapper;
-            
+            using Scalar = typename std::decay_t<T>::Scalar;
+
+            //Column-major matrices are written as they are in memory with swapped dimensions (marked by an attribute).
+            //With dontReorderData they are stored with their own dimensions instead and transposed chunk by chunk.
+            constexpr bool columnmajor = !(T::IsRowMajor) && !T::IsVectorAtCompileTime;
+            const bool asis = columnmajor && !mOptions.dontReorderData;
+
             const HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
 
             //Creating the dataset! 
@@ -429,40 +892,28 @@ namespace Archives
             const auto dataspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
 
             //Settings storage dimensions
+            const auto rows = static_cast<hsize_t>(val.rows());
+            const auto cols = static_cast<hsize_t>(val.cols());
             HDF5_DataspaceOptions dataspaceopts;
-            dataspaceopts.dims = std::vector<hsize_t>{ { static_cast<hsize_t>(val.rows()), static_cast<hsize_t>(val.cols()) } };
-            dataspaceopts.maxdims = std::vector<hsize_t>{ { static_cast<hsize_t>(val.rows()), static_cast<hsize_t>(val.cols()) } };
+            dataspaceopts.dims = asis ? std::vector<hsize_t>{ { cols, rows } } : std::vector<hsize_t>{ { rows, cols } };
+            dataspaceopts.maxdims = dataspaceopts.dims;
 
-            HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(*val.data(), datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
-            HDF5_DatasetOptions datasetopts;
+            HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(Scalar{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+            HDF5_DatasetOptions datasetopts{ datasetOptions() };
             HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
-            
-            //Creating the memory space
-            const auto memoryspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
-            const auto memorytypeopts{ mOptions.DefaultDatatypeOptions };
-
-            //Settings memory dimensions
-            HDF5_DataspaceOptions memoryspaceopt;
-            memoryspaceopt.dims = std::vector<hsize_t>{ { static_cast<hsize_t>(val.rows()), static_cast<hsize_t>(val.cols()) } };
-            memoryspaceopt.maxdims = std::vector<hsize_t>{ { static_cast<hsize_t>(val.rows()), static_cast<hsize_t>(val.cols()) } };
-            HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(*val.data(), memorytypeopts), HDF5_DataspaceWrapper(memoryspacetype, memoryspaceopt) };
+            HDF5_ArchiveHelper::setColumnMajor(dataset, asis);
 
-            if (mOptions.dontReorderData)
-            {
-                if constexpr (!(T::IsRowMajor) && !T::IsVectorAtCompileTime)
-                { //Converting from Columnmajor to rowmajor
-                    Eigen::Matrix<typename T::Scalar, T::RowsAtCompileTime, T::ColsAtCompileTime, Eigen::RowMajor> TransposedMatrix = val;
-                    dataset.writeData(TransposedMatrix, memoryopts);
-                }
-                else
-                {
-                    dataset.writeData(val, memoryopts);
-                }
-            }
-            else
+            if (val.size() == 0)
+                return;
+            if (columnmajor && !asis)
             {
-                dataset.writeData(val, memoryopts);
+                writeTransposed(dataset, {}, val.data(), rows, cols);
+                return;
             }
+            //The memory space describes the storage of the matrix itself; no copy is made
+            HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(Scalar{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+            if (dataset.writeBuffer(val.data(), memoryopts) < 0)
+                throw std::runtime_error{ "Unable to write HDF5 dataset '" + std::string{ nextPath } + "'!" };
         }
 
         template <typename T>
@@ -475,41 +926,99 @@ namespace Archives
             using EigenType = std::decay_t<typename std::decay_t<T>::value_type>;
             using Scalar = typename EigenType::Scalar;
 
+            //Same layout as single matrices (see above) with the index of the matrix as leading dimension
+            constexpr bool columnmajor = !(EigenType::IsRowMajor) && !EigenType::IsVectorAtCompileTime;
+            const bool asis = columnmajor && !mOptions.dontReorderData;
+
+            const auto rows = val.size() == 0 ? hsize_t{ 0 } : static_cast<hsize_t>(val.begin()->rows());
+            const auto cols = val.size() == 0 ? hsize_t{ 0 } : static_cast<hsize_t>(val.begin()->cols());
+            for (const auto& elem : val)
+            {
+                if (static_cast<hsize_t>(elem.rows()) != rows || static_cast<hsize_t>(elem.cols()) != cols)
+                    throw std::runtime_error{ "All matrices stored in HDF5 dataset '" + std::string{ nextPath } + "' must have the same dimensions!" };
+            }
+
             //Creating the dataset! 
             const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
             const auto dataspacetype = DataspaceTypeSelector<EigenType>::value();
 
             //Settings storage dimensions
             HDF5_DataspaceOptions dataspaceopts;
-            dataspaceopts.dims = std::vector<hsize_t>{ { val.size(),static_cast<hsize_t>(val[0].rows()), static_cast<hsize_t>(val[0].cols()) } };
+            dataspaceopts.dims = asis ? std::vector<hsize_t>{ { val.size(), cols, rows } } : std::vector<hsize_t>{ { val.size(), rows, cols } };
             dataspaceopts.maxdims = dataspaceopts.dims;
 
             HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(Scalar{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
-            HDF5_DatasetOptions datasetopts;
+            HDF5_DatasetOptions datasetopts{ datasetOptions() };
             HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
+            HDF5_ArchiveHelper::setColumnMajor(dataset, asis);
 
-            //Creating the memory space
-            const auto memoryspacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
-            const auto memorytypeopts{ mOptions.DefaultDatatypeOptions };
+            if (val.size() == 0 || rows * cols == 0)
+                return;
 
-            //Settings memory dimensions
+            //Fixed size matrices in contiguous containers are written with a single call
+            if constexpr (stdext::is_memory_sequentiel_container_v<std::decay_t<T>> && EigenType::SizeAtCompileTime != Eigen::Dynamic
+                          && sizeof(EigenType) == sizeof(Scalar) * static_cast<std::size_t>(EigenType::SizeAtCompileTime))
+            {
+                if (!(columnmajor && !asis))
+                {
+                    HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(Scalar{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
+                    if (dataset.writeBuffer(val.data()->data(), memoryopts) < 0)
+                        throw std::runtime_error{ "Unable to write HDF5 dataset '" + std::string{ nextPath } + "'!" };
+                    return;
+                }
+            }
+
+            //Otherwise every matrix is written from its own storage into its slab of the dataset
+            auto stordataspace = dataset.getDataspace();
             HDF5_DataspaceOptions memoryspaceopt;
-            memoryspaceopt.dims = std::vector<hsize_t>{ { val.size(),static_cast<hsize_t>(val[0].rows()), static_cast<hsize_t>(val[0].cols()) } };
-            memoryspaceopt.maxdims = std::vector<hsize_t>{ { val.size(),static_cast<hsize_t>(val[0].rows()), static_cast<hsize_t>(val[0].cols()) } };
-            HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(Scalar{}, memorytypeopts), HDF5_DataspaceWrapper(memoryspacetype, memoryspaceopt) };
+            memoryspaceopt.dims = std::vector<hsize_t>{ { rows * cols } };
+            memoryspaceopt.maxdims = memoryspaceopt.dims;
+            HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(Scalar{}, datatypeopts), HDF5_DataspaceWrapper(dataspacetype, memoryspaceopt) };
+            std::size_t index{ 0 };
+            for (const auto& elem : val)
+            {
+                if (columnmajor && !asis)
+                {
+                    writeTransposed(dataset, { index++ }, elem.data(), rows, cols);
+                    continue;
+                }
+                stordataspace.selectSlab(H5S_SELECT_SET, { index++, 0, 0 }, { 1, 1, 1 }, { 1, dataspaceopts.dims[1], dataspaceopts.dims[2] }, { 1, 1, 1 });
+                if (dataset.writeBuffer(elem.data(), memoryopts, stordataspace) < 0)
+                    throw std::runtime_error{ "Unable to write HDF5 dataset '" + std::string{ nextPath } + "'!" };
+            }
+        }
 
-            //HDF5_DataspaceWrapper memoryspace(memoryspacetype, memoryspaceopt);
+        //Writes the column-major matrix data (rows x cols) with its own dimensions at the position given by
+        //the leading indices; the data is transposed chunk by chunk in the staging buffer
+        template <typename Scalar>
+        void writeTransposed(const HDF5_Wrapper::HDF5_DatasetWrapper& dataset, std::vector<std::size_t> start, const Scalar* data, std::size_t rows, std::size_t cols)
+        {
+            using namespace HDF5_Wrapper;
 
-            if constexpr (!(EigenType::IsRowMajor) && !EigenType::IsVectorAtCompileTime)
-            { //Converting from Columnmajor to rowmajor
-                Eigen::Matrix<typename EigenType::Scalar, EigenType::RowsAtCompileTime, EigenType::ColsAtCompileTime, Eigen::RowMajor> TransposedMatrix = val;
-                //HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(*val.data(), memorytypeopts), std::move(memoryspace) };
-                dataset.writeData(TransposedMatrix, memoryopts);
-            }
-            else
+            const auto chunkrows = std::max<std::size_t>(mStaging.chunkSize<Scalar>(rows * cols) / cols, 1);
+            const auto buffer = mStaging.get<Scalar>(chunkrows * cols);
+
+            auto stordataspace = dataset.getDataspace();
+            std::vector<std::size_t> count(start.size(), 1);
+            start.insert(start.end(), { 0, 0 });
+            count.insert(count.end(), { 0, cols });
+            const std::vector<std::size_t> ones(start.size(), 1);
+            for (std::size_t row = 0; row < rows; row += chunkrows)
             {
-                //HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(*val.data(), memorytypeopts), std::move(memoryspace) };
-                dataset.writeData(val, memoryopts);
+                const auto chunk = std::min(chunkrows, rows - row);
+                for (std::size_t i = 0; i < chunk; ++i)
+                    for (std::size_t col = 0; col < cols; ++col)
+                        buffer[i * cols + col] = data[col * rows + row + i];
+
+                start[start.size() - 2] = row;
+                count[count.size() - 2] = chunk;
+                stordataspace.selectSlab(H5S_SELECT_SET, start, ones, count, ones);
+                HDF5_DataspaceOptions memoryspaceopt;
+                memoryspaceopt.dims = std::vector<hsize_t>{ { chunk * cols } };
+                memoryspaceopt.maxdims = memoryspaceopt.dims;
+                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(Scalar{}, mOptions.DefaultDatatypeOptions), HDF5_DataspaceWrapper(H5S_SIMPLE, memoryspaceopt) };
+                if (dataset.writeBuffer(buffer.data(), memoryopts, stordataspace) < 0)
+                    throw std::runtime_error{ "Unable to write HDF5 dataset '" + std::string{ nextPath } + "'!" };
             }
         }
 
@@ -535,7 +1044,7 @@ namespace Archives
             std::reverse_copy(valdims.begin(), valdims.end(), dataspaceopts.maxdims.begin());
 
             HDF5_StorageOptions storeopts{ HDF5_DatatypeWrapper(*val.data(), datatypeopts), HDF5_DataspaceWrapper(dataspacetype, dataspaceopts) };
-            HDF5_DatasetOptions datasetopts;
+            HDF5_DatasetOptions datasetopts{ datasetOptions() };
             HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(storeopts), std::move(datasetopts));
 
             //Creating the memory space
@@ -567,6 +1076,8 @@ namespace Archives
         HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode FileCreationMode{ HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode::Open };
         HDF5_Wrapper::HDF5_DatatypeOptions			 DefaultDatatypeOptions{};
         HDF5_Wrapper::HDF5_DataspaceOptions			 DefaultDataspaceOptions{};
+        std::size_t									 StagingBufferBytes{ 1024 * 1024 };	// Non-contiguous containers are read in chunks of this size
+        std::pmr::memory_resource*					 MemoryResource{ nullptr };	// Group stack and paths; nullptr = arena owned by the archive
     };
 
 
@@ -581,7 +1092,7 @@ namespace Archives
         using Options = HDF5_InputOptions;
 
         HDF5_InputArchive(const std::filesystem::path &path, const HDF5_InputOptions& options)
-            : InputArchive(this), mFile(openFile(path, options)), mOptions(options) {
+            : InputArchive(this), mFile(openFile(path, options)), mMemory(options.MemoryResource), mOptions(options) {
             static_assert(std::is_same_v<ThisClass, std::decay_t<decltype(*this)>>);
         };
 
@@ -595,6 +1106,33 @@ namespace Archives
             clearNextPath();	//Remove the Fieldname
         };
 
+        //Views (std::span/std::mdspan) are read directly into the viewed memory; the dataset must fit the extents of the view
+        template<typename T> requires (SerAr::IsArrayView<std::remove_cvref_t<T>>)
+        inline void load(Archives::NamedValue<T>& value)
+        {
+            setNextPath(value.getName());
+            readArrayView(value.getName(), arrayViewData(value.getValue()), arrayViewExtents(value.getValue()));
+            clearNextPath();
+        };
+
+        //The layout only matters for writing; HDF5 applies the stored filters on reading
+        template<typename T>
+        inline void load(HDF5_NamedValueWithLayout<T>& value)
+        {
+            this->operator()(value.value);
+        };
+
+        //Only records the dataset/group path. The data is read on first access of the Deferred.
+        template<typename T>
+        inline void load(Archives::NamedValue<Deferred<T>&>& value)
+        {
+            if (!isValidNextLocation(value.getName()))
+                throw std::runtime_error{ "Invalid HDF5 path string!" };
+            std::string location{ mLocation };
+            location.append("/").append(value.getName());
+            value.getValue().setLoader(std::move(location), [this](std::string_view loc, T& target) { loadAt(loc, target); });
+        };
+
         template<typename T>
         inline std::enable_if_t< HDF5_traits::has_getData_from_HDF5_v<std::decay_t<T>> > load(T& value)
         {
@@ -621,16 +1159,74 @@ namespace Archives
             closeLastGroup();
         };
 
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Loads a single nested value without loading the enclosing structs.
+        /// 			Only the groups along the path are opened. </summary>
+        ///
+        /// <param name="path">	Names of the NamedValues from the root separated by '.' (e.g. "mytest.mynested.mydouble"). </param>
+        ///-------------------------------------------------------------------------------------------------
+        template<typename T>
+        void load_path(std::string_view path, T& value)
+        {
+            if (path.empty())
+                throw std::runtime_error{ "Empty path given to load_path!" };
+            std::string location{ "/" };
+            location.append(path);
+            std::replace(location.begin(), location.end(), '.', '/');
+            loadAt(location, value);
+        }
+
+        // Checks for a dataset or group of the given name in the current group (see SerAr::HasFieldLookup)
+        bool contains(std::string_view name) const
+        {
+            const HDF5_Wrapper::HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_Wrapper::HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
+            const std::string link{ name };
+            return H5Lexists(currentLoc, link.c_str(), H5P_DEFAULT) > 0;
+        }
+
+        // Shared objects (see SerAr::HasSharedObjectLoad). Hard links to the same object share the
+        // address of the object which is used as identity.
+        inline ObjectTracker& objectTracker() noexcept { return mObjects; }
+        std::string objectIdentity(std::string_view name) const
+        {
+            if (name.empty())
+                throw std::runtime_error{ "HDF5 archives can only load named shared objects!" };
+            const HDF5_Wrapper::HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_Wrapper::HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
+            const std::string link{ name };
+#if H5_VERSION_GE(1, 12, 0)
+            H5O_info2_t info;
+            const auto herr = H5Oget_info_by_name3(currentLoc, link.c_str(), &info, H5O_INFO_BASIC, H5P_DEFAULT);
+            const auto& address = info.token;
+#else
+            H5O_info_t info;
+            const auto herr = H5Oget_info_by_name2(currentLoc, link.c_str(), &info, H5O_INFO_BASIC, H5P_DEFAULT);
+            const auto& address = info.addr;
+#endif
+            if (herr < 0)
+                throw std::runtime_error{ "Unable to find HDF5 object '" + link + "'!" };
+            std::string identity(sizeof(address) * 2, '0');
+            const auto bytes = reinterpret_cast<const unsigned char*>(&address);
+            for (std::size_t i = 0; i < sizeof(address); ++i) {
+                identity[2 * i] = "0123456789abcdef"[bytes[i] >> 4];
+                identity[2 * i + 1] = "0123456789abcdef"[bytes[i] & 0xf];
+            }
+            return identity;
+        }
+
     private:
         using CurrentGroup = HDF5_Wrapper::HDF5_GroupWrapper;
         //using LastDataset = HDF5_Wrapper::HDF5_DatasetWrapper;
         using File = HDF5_Wrapper::HDF5_FileWrapper;
 
         File							mFile;
-        std::stack<CurrentGroup>		mGroupStack;
-        std::string nextPath;
+        ArchiveMemoryResource			mMemory;
+        pmr_stack<CurrentGroup>			mGroupStack{ mMemory.get() };
+        std::pmr::string nextPath{ mMemory.get() };
+        std::pmr::string mLocation{ mMemory.get() };	//Absolute path of the current group (only used for Deferred)
 
         HDF5_InputOptions mOptions;
+        HDF5_StagingBuffer mStaging{ mMemory.get(), mOptions.StagingBufferBytes };
+        ObjectTracker mObjects{};
 
         static File openFile(const std::filesystem::path &path, const HDF5_InputOptions& options)
         {
@@ -643,20 +1239,20 @@ namespace Archives
         }
 
         //TODO: Move those function into another class which can also be used by the Output Archive
-        void setNextPath(const std::string& str)
+        void setNextPath(std::string_view str)
         {
             if (!isValidNextLocation(str))
                 throw std::runtime_error{ "Invalid HDF5 path string!" };
 
             assert(nextPath.empty());
 
-            nextPath = str;
+            nextPath.assign(str); // reuses the capacity of nextPath; no allocation per field
         }
         void clearNextPath()
         {
             nextPath.clear();
         }
-        bool isValidNextLocation(const std::string&) const
+        bool isValidNextLocation(std::string_view) const
         {
             //TODO: Check the Location name for invalid characters
             return true;
@@ -675,14 +1271,50 @@ namespace Archives
             opts.mode = HDF5_GeneralOptions::HDF5_Mode::Open;
             HDF5_GroupWrapper group{ currentLoc, nextPath, opts };
             mGroupStack.push(std::move(group));
+            mLocation.append("/").append(nextPath);
         }
 
         void closeLastGroup()
         {
             assert(!mGroupStack.empty());
             mGroupStack.pop(); // Just pop it from the stack. The Destructor will close it!
+            mLocation.resize(mLocation.rfind('/'));
         };
 
+        //Loads value from an absolute location ('/' separated). The current position within the file is restored afterwards.
+        template<typename T>
+        void loadAt(std::string_view location, T& value)
+        {
+            struct RestorePosition {
+                HDF5_InputArchive& ar;
+                pmr_stack<CurrentGroup> groups;
+                std::pmr::string location;
+                std::pmr::string path;
+                explicit RestorePosition(HDF5_InputArchive& archive)
+                    : ar(archive), groups(archive.mMemory.get()), location(archive.mMemory.get()), path(archive.mMemory.get()) {
+                    std::swap(groups, ar.mGroupStack);
+                    std::swap(location, ar.mLocation);
+                    std::swap(path, ar.nextPath);
+                }
+                ~RestorePosition() {
+                    std::swap(groups, ar.mGroupStack);
+                    std::swap(location, ar.mLocation);
+                    std::swap(path, ar.nextPath);
+                }
+            } restore{ *this };
+
+            assert(!location.empty() && location.front() == '/');
+            location.remove_prefix(1);
+            for (auto pos = location.find('/'); pos != location.npos; pos = location.find('/')) {
+                setNextPath(location.substr(0, pos));
+                openGroup(value);
+                clearNextPath();
+                location.remove_prefix(pos + 1);
+            }
+            auto nvalue = Archives::createNamedValue(location, value);
+            this->operator()(nvalue);
+        }
+
         template<typename T>
         std::enable_if_t<std::is_arithmetic_v<std::decay_t<T>> ||
             stdext::is_complex_v<std::decay_t<T>> ||
@@ -718,7 +1350,7 @@ namespace Archives
 
 
         template<typename T>
-        std::enable_if_t<stdext::is_arithmetic_container_v<std::decay_t<T>> && !stdext::is_associative_container_v<std::decay_t<T>> > getData(T& val)
+        std::enable_if_t<stdext::is_arithmetic_container_v<std::decay_t<T>> > getData(T& val)
         {
             using namespace HDF5_Wrapper;
 
@@ -726,6 +1358,7 @@ namespace Archives
 
             if constexpr (stdext::is_memory_sequentiel_container_v<std::decay_t<T>>)
             {
+                using DataType = std::remove_cv_t<typename std::decay_t<T>::value_type>;
                 const auto spacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
                 HDF5_DataspaceOptions spaceopts;
 
@@ -734,7 +1367,7 @@ namespace Archives
                 HDF5_DatasetOptions datasetopts{};
                 HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(datasetopts));
 
-                HDF5_DatatypeWrapper type(val[0], datatypeopts);
+                HDF5_DatatypeWrapper type(DataType{}, datatypeopts); // The container may still be empty
                 assert(dataset.getDatatype() == type);
 
                 const auto& dataspace{ dataset.getDataspace() };
@@ -747,51 +1380,77 @@ namespace Archives
                 HDF5_DataspaceOptions memoryspaceopt;
                 memoryspaceopt.dims = std::vector<hsize_t>{ { val.size() } };
                 memoryspaceopt.maxdims = std::vector<hsize_t>{ { val.size() } };
-                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(val[0], datatypeopts), HDF5_DataspaceWrapper(spacetype, memoryspaceopt) };
+                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(DataType{}, datatypeopts), HDF5_DataspaceWrapper(spacetype, memoryspaceopt) };
                 dataset.readData(val.data(), memoryopts);
             }
-            else if constexpr(!stdext::is_associative_container_v<std::decay_t<T>>)
+            else
             {
+                //Non-contiguous containers (e.g. std::list, std::deque, std::set) are read chunk by chunk into the staging buffer
+                using DataType = std::remove_cv_t<typename std::decay_t<T>::value_type>;
                 const auto spacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
-                HDF5_DataspaceOptions spaceopts;
 
                 const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
 
                 HDF5_DatasetOptions datasetopts{};
                 HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(datasetopts));
 
-                HDF5_DatatypeWrapper type(val[0], datatypeopts);
-                assert(dataset.getDatatype() == type);
-
                 const auto& dataspace{ dataset.getDataspace() };
                 const auto dims = dataspace.getDimensions();
 
                 assert(dims.size() == 1);
 
-                val.resize(dims.at(0));
+                const auto size = dims.at(0);
+                if constexpr (stdext::is_associative_container_v<std::decay_t<T>>)
+                    val.clear();
+                else
+                    val.resize(size);
 
                 HDF5_DataspaceWrapper stordataspace(dataspace);
-                stordataspace.removeSelection();
-                stordataspace.selectSlab(H5S_SELECT_SET, { 0 }, { 1 }, { 1 }, { 1 });
-
-                HDF5_DataspaceOptions memoryspaceopt;
-                memoryspaceopt.dims = std::vector<hsize_t>{ { val.size() } };
-                memoryspaceopt.maxdims = std::vector<hsize_t>{ { val.size() } };
-                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(val[0], datatypeopts), stordataspace };
-                std::vector<std::int64_t> offset{ { 0 } };
-                for (auto& elem : val)
+                const auto chunk = mStaging.chunkSize<DataType>(size);
+                const auto buffer = mStaging.get<DataType>(chunk);
+                auto elem = val.begin();
+                for (std::size_t offset = 0; offset < size; offset += chunk)
                 {
-                    dataset.readData(elem, memoryopts, stordataspace);
-                    ++(offset[0]);
-                    stordataspace.setOffset(offset);
+                    const auto count = std::min(chunk, size - offset);
+                    stordataspace.selectSlab(H5S_SELECT_SET, { offset }, { 1 }, { count }, { 1 });
+                    HDF5_DataspaceOptions memoryspaceopt;
+                    memoryspaceopt.dims = std::vector<hsize_t>{ { count } };
+                    memoryspaceopt.maxdims = memoryspaceopt.dims;
+                    HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(DataType{}, datatypeopts), HDF5_DataspaceWrapper(spacetype, memoryspaceopt) };
+                    if (dataset.readData(buffer.data(), memoryopts, stordataspace) < 0)
+                        throw std::runtime_error{ "Unable to read HDF5 dataset '" + std::string{ nextPath } + "'!" };
+
+                    if constexpr (stdext::is_associative_container_v<std::decay_t<T>>)
+                        val.insert(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+                    else
+                        elem = std::copy_n(buffer.begin(), count, elem);
                 }
             }
-            else
-            {
-                static_assert(!stdext::is_memory_sequentiel_container_v<std::decay_t<T>>, "Case not implemented yet! Please implement it!");
-                //How to do it: For sequentiell containers: Write elements one at a time in a for loop into the dataset. Needs selection of appropiate dataspaces!
-                // For associative containers: Open 
-            }
+        }
+
+        template<typename T, std::size_t Rank>
+        void readArrayView(std::string_view name, std::span<T> data, const std::array<std::size_t, Rank>& extents)
+        {
+            static_assert(!std::is_const_v<T>, "Cannot load into a view of const elements!");
+            using namespace HDF5_Wrapper;
+
+            const HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
+
+            HDF5_DatasetOptions datasetopts{};
+            HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(datasetopts));
+
+            const auto dims = dataset.getDataspace().getDimensions();
+            checkArrayViewExtents(name, dims, extents);
+
+            //The memory space describes the viewed buffer itself; HDF5 converts the stored datatype if necessary
+            const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
+            const auto memoryspacetype = Rank == 0 ? H5S_SCALAR : H5S_SIMPLE;
+            HDF5_DataspaceOptions memoryspaceopt;
+            memoryspaceopt.dims.assign(extents.begin(), extents.end());
+            memoryspaceopt.maxdims = memoryspaceopt.dims;
+            HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(T{}, datatypeopts), HDF5_DataspaceWrapper(memoryspacetype, memoryspaceopt) };
+            if (!data.empty() && dataset.readData(data.data(), memoryopts) < 0)
+                throw std::runtime_error{ "Unable to read HDF5 dataset '" + std::string{ name } + "'!" };
         }
 
         template<typename T>
@@ -803,93 +1462,136 @@ namespace Archives
             const HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
 
             const auto spacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
-            HDF5_DataspaceOptions spaceopts;
 
             const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
 
             HDF5_DatasetOptions datasetopts{};
             HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(datasetopts));
 
-            HDF5_DatatypeWrapper type(val[0], datatypeopts);
-            assert(dataset.getDatatype() == type);
-
             const auto& dataspace{ dataset.getDataspace() };
             const auto dims = dataspace.getDimensions();
 
             assert(dims.size() == 1);
 
             val.resize(dims.at(0));
-
-            HDF5_DataspaceWrapper stordataspace(dataspace);
-            stordataspace.removeSelection();
-            stordataspace.selectSlab(H5S_SELECT_SET, { 0 }, { 1 }, { 1 }, { 1 });
+            if (val.empty())
+                return;
 
             HDF5_DataspaceOptions memoryspaceopt;
             memoryspaceopt.dims = std::vector<hsize_t>{ { val.size() } };
             memoryspaceopt.maxdims = std::vector<hsize_t>{ { val.size() } };
-            HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(val[0], datatypeopts), stordataspace };
-            std::vector<std::int64_t> offset{ { 0 } };
-            for (auto& str : val)
+
+            //All strings are read with a single call
+            const auto type = dataset.getDatatype();
+            if (H5Tis_variable_str(type) > 0)
             {
-                dataset.readData(str, memoryopts, stordataspace);
-                ++(offset[0]);
-                stordataspace.setOffset(offset);
+                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(std::string{}, datatypeopts), HDF5_DataspaceWrapper(spacetype, memoryspaceopt) };
+                struct Strings {
+                    std::vector<char*> data;
+                    const HDF5_MemoryOptions& memoryopts;
+                    ~Strings() { H5Dvlen_reclaim(memoryopts.datatype, memoryopts.dataspace, H5P_DEFAULT, data.data()); } //Frees the memory allocated by HDF5
+                } strings{ std::vector<char*>(val.size(), nullptr), memoryopts };
+                if (dataset.readData(strings.data.data(), memoryopts) < 0)
+                    throw std::runtime_error{ "Unable to read HDF5 dataset '" + std::string{ nextPath } + "'!" };
+                auto str = strings.data.begin();
+                for (auto& elem : val)
+                {
+                    if (*str)
+                        elem.assign(*str);
+                    else
+                        elem.clear();
+                    ++str;
+                }
+            }
+            else // => fixed-length strings; padding and terminators are removed
+            {
+                const auto length = type.getSize();
+                std::string packed(val.size() * length, '\0');
+                HDF5_MemoryOptions memoryopts{ type, HDF5_DataspaceWrapper(spacetype, memoryspaceopt) };
+                if (dataset.readData(packed.data(), memoryopts) < 0)
+                    throw std::runtime_error{ "Unable to read HDF5 dataset '" + std::string{ nextPath } + "'!" };
+                std::string_view strings{ packed };
+                for (auto& elem : val)
+                {
+                    const auto str = strings.substr(0, length);
+                    elem.assign(str.substr(0, str.find('\0')));
+                    strings.remove_prefix(length);
+                }
             }
-        
         }
 #ifdef EIGEN_CORE_H
         template<typename T>
         std::enable_if_t<stdext::is_eigen_type_v<std::decay_t<T>>> getData(T& val)
         {
             using namespace HDF5_Wrapper;
+            using Type = std::decay_t<T>;
+            using Scalar = typename Type::Scalar;
 
             const HDF5_LocationWrapper& currentLoc = mGroupStack.empty() ? static_cast<const HDF5_LocationWrapper&>(mFile) : mGroupStack.top();
 
             const auto spacetype = DataspaceTypeSelector<std::decay_t<T>>::value();
-            HDF5_DataspaceOptions spaceopts;
 
             const auto datatypeopts{ mOptions.DefaultDatatypeOptions };
 
             HDF5_DatasetOptions datasetopts{};
             HDF5_DatasetWrapper dataset(currentLoc, nextPath, std::move(datasetopts));
 
-            HDF5_DatatypeWrapper type(val(0,0), datatypeopts);
-            assert(dataset.getDatatype() == type);
-
             const auto& dataspace{ dataset.getDataspace() };
             const auto dims = dataspace.getDimensions();
+            if (dims.size() != 2)
+                throw std::runtime_error{ "HDF5 dataset '" + std::string{ nextPath } + "' does not contain a matrix!" };
+
+            //Column-major matrices may be stored as they are in memory with swapped dimensions (see HDF5_OutputArchive)
+            const bool storedcolumnmajor = HDF5_ArchiveHelper::isColumnMajor(dataset);
+            const std::size_t rows{ storedcolumnmajor ? dims[1] : dims[0] }, cols{ storedcolumnmajor ? dims[0] : dims[1] };
+            if ((Type::RowsAtCompileTime != Eigen::Dynamic && rows != static_cast<std::size_t>(Type::RowsAtCompileTime))
+                || (Type::ColsAtCompileTime != Eigen::Dynamic && cols != static_cast<std::size_t>(Type::ColsAtCompileTime)))
+                throw std::runtime_error{ "Stored matrix '" + std::string{ nextPath } + "' does not fit the dimensions of the matrix it is loaded into!" };
+            val.resize(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(cols));
+            if (val.size() == 0)
+                return;
+
+            //The data is read directly into the storage of the matrix. Only if the storage orders differ it is
+            //transposed chunk by chunk in the staging buffer.
+            if (storedcolumnmajor == !Type::IsRowMajor || rows == 1 || cols == 1)
+            {
+                HDF5_DataspaceOptions memoryspaceopt;
+                memoryspaceopt.dims = std::vector<hsize_t>{ { dims[0], dims[1] } };
+                memoryspaceopt.maxdims = memoryspaceopt.dims;
+                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(Scalar{}, datatypeopts), HDF5_DataspaceWrapper(spacetype, memoryspaceopt) };
+                if (dataset.readData(val.data(), memoryopts) < 0)
+                    throw std::runtime_error{ "Unable to read HDF5 dataset '" + std::string{ nextPath } + "'!" };
+            }
+            else
+            {
+                readTransposed(dataset, dims[0], dims[1], val.data());
+            }
+        }
 
-            //TODO: add code for dynamic sized matrix!
-            //TODO: Check dimension of Vector!
-
-            assert(dims.size() == 2);
-
-            const std::size_t cols{ dims.at(1) }, rows{ dims.at(0) };
-
-            //Eigen::Matrix<typename T::Scalar, Eigen::Dynamic, Eigen::Dynamic> Storage(cols, rows);
+        //Reads the stored rows x cols data into the transposed memory layout; chunk by chunk through the staging buffer
+        template <typename Scalar>
+        void readTransposed(const HDF5_Wrapper::HDF5_DatasetWrapper& dataset, std::size_t rows, std::size_t cols, Scalar* data)
+        {
+            using namespace HDF5_Wrapper;
 
-            HDF5_DataspaceOptions memoryspaceopt;
-            memoryspaceopt.dims = std::vector<hsize_t>{ { static_cast<hsize_t>(rows), static_cast<hsize_t>(cols) } };
-            memoryspaceopt.maxdims = std::vector<hsize_t>{ { static_cast<hsize_t>(rows), static_cast<hsize_t>(cols) } };
-            HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(val(0,0), datatypeopts), HDF5_DataspaceWrapper(spacetype, memoryspaceopt) };
+            const auto chunkrows = std::max<std::size_t>(mStaging.chunkSize<Scalar>(rows * cols) / cols, 1);
+            const auto buffer = mStaging.get<Scalar>(chunkrows * cols);
 
-            //TODO: add code for dynamic sized matrix!
-            if constexpr (!(T::IsRowMajor) && !T::IsVectorAtCompileTime)
-            { //Converting from Columnmajor to rowmajor
-                std::vector<typename T::Scalar> vec(cols*rows);
-                //Eigen::Matrix<typename T::Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> TransposedMatrix(dims.at);
-                //HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(*val.data(), memorytypeopts), std::move(memoryspace) };
-                dataset.readData(vec.data(), memoryopts);
-                //Eigen::Map< EigenMatrix, Eigen::Unaligned, Eigen::Stride<1, EigenMatrix::ColsAtCompileTime> >
-                //val = Eigen::Map<std::decay_t<T>, Eigen::Unaligned>(vec.data(),rows,cols);
-                //val = Eigen::Map<std::decay_t<T>, Eigen::Unaligned, Eigen::Stride<1, std::decay_t<T>::ColsAtCompileTime>>(vec.data(), rows, cols);
-                val = Eigen::Map<std::decay_t<T>, Eigen::Unaligned, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>(vec.data(), rows, cols, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(1,cols));
-                //Map<MatrixXi, 0, OuterStride<> >(array, 3, 3, OuterStride<>(4)) <_ for dynamic size?
-            }
-            else
+            auto stordataspace = dataset.getDataspace();
+            for (std::size_t row = 0; row < rows; row += chunkrows)
             {
-                //HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(*val.data(), memorytypeopts), std::move(memoryspace) };
-                dataset.readData(val, memoryopts);
+                const auto chunk = std::min(chunkrows, rows - row);
+                stordataspace.selectSlab(H5S_SELECT_SET, { row, 0 }, { 1, 1 }, { chunk, cols }, { 1, 1 });
+                HDF5_DataspaceOptions memoryspaceopt;
+                memoryspaceopt.dims = std::vector<hsize_t>{ { chunk * cols } };
+                memoryspaceopt.maxdims = memoryspaceopt.dims;
+                HDF5_MemoryOptions memoryopts{ HDF5_DatatypeWrapper(Scalar{}, mOptions.DefaultDatatypeOptions), HDF5_DataspaceWrapper(H5S_SIMPLE, memoryspaceopt) };
+                if (dataset.readData(buffer.data(), memoryopts, stordataspace) < 0)
+                    throw std::runtime_error{ "Unable to read HDF5 dataset '" + std::string{ nextPath } + "'!" };
+
+                for (std::size_t i = 0; i < chunk; ++i)
+                    for (std::size_t col = 0; col < cols; ++col)
+                        data[col * rows + row + i] = buffer[i * cols + col];
             }
         }
 #ifdef EIGEN_CXX11_TENSOR_TENSOR_H
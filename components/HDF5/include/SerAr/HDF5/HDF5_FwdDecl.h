@@ -37,6 +37,7 @@ namespace HDF5_Wrapper
 	//Extra Options without linkage
 	struct HDF5_DataspaceOptions;
 	struct HDF5_DatatypeOptions;
+	struct HDF5_DatasetLayoutOptions;
 
 
 	inline bool isTypeImmutable(const hid_t& dtype);
@@ -18,7 +18,12 @@
 
 #include <type_traits>
 
+#include <algorithm>
 #include <filesystem>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 #include <utility>
 #include <string_view>
 #include <string>
@@ -147,8 +152,9 @@ namespace HDF5_Wrapper
         inline std::string getHDF5Path() const noexcept
         {
             const auto size = static_cast<std::size_t>(H5Iget_name(mLocation, nullptr, 0) + 1); // +1 for null terminator
-            std::string res(size, ' ');
+            std::string res(size, '\0');
             H5Iget_name(mLocation, res.data(), size);
+            res.resize(size - 1);
             return res;
         }
 
@@ -677,10 +683,105 @@ namespace HDF5_Wrapper
         //ALLOW_DEFAULT_MOVE_AND_ASSIGN(HDF5_StorageOptions)
     };
 
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Chunking and filter pipeline of newly created datasets. Filters require chunking;
+    /// 			if filters are enabled without chunking the chunk shape is chosen automatically.
+    /// 			Reading needs no options since HDF5 applies the stored filters itself. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    struct HDF5_DatasetLayoutOptions
+    {
+        enum class HDF5_Chunking { None, Auto, Explicit };
+        HDF5_Chunking chunking{ HDF5_Chunking::None };
+        std::vector<hsize_t> chunk_dims{};				// Chunk shape for HDF5_Chunking::Explicit; clamped to fixed dataset dimensions
+        std::size_t chunk_target_bytes{ 1024 * 1024 };	// Upper bound for HDF5_Chunking::Auto; the default chunk cache of HDF5 holds 1 MiB
+        bool shuffle{ false };							// Byte shuffle in front of the compression
+        unsigned int deflate_level{ 0 };				// gzip compression level 1-9; 0 disables deflate
+        bool szip{ false };								// Requires a HDF5 library with szip encoder
+        unsigned int szip_pixels_per_block{ 16 };
+        bool fletcher32{ false };						// Checksum of every chunk
+
+        bool hasFilters() const noexcept
+        {
+            return shuffle || deflate_level > 0 || szip || fletcher32;
+        }
+        bool isChunked() const noexcept
+        {
+            return chunking != HDF5_Chunking::None || hasFilters();
+        }
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Chunk shape for a dataset of the given dimensions. </summary>
+        ///
+        /// <returns>	The chunk dimensions or an empty vector if the dataset cannot be chunked
+        /// 			(a fixed dimension of size 0). </returns>
+        ///-------------------------------------------------------------------------------------------------
+        std::vector<hsize_t> getChunkDimensions(const std::vector<hsize_t>& dims, const std::vector<hsize_t>& maxdims, std::size_t typesize) const
+        {
+            assert(dims.size() == maxdims.size());
+            std::vector<hsize_t> chunk(dims.size());
+            for (std::size_t dim = 0; dim < dims.size(); ++dim)
+            {
+                const bool unlimited = maxdims[dim] == H5S_UNLIMITED;
+                if (!unlimited && dims[dim] == 0)
+                    return {};
+                if (chunking == HDF5_Chunking::Explicit)
+                {
+                    if (chunk_dims.size() != dims.size())
+                        throw std::runtime_error{ "Rank of the HDF5 chunk dimensions does not match the rank of the dataset!" };
+                    chunk[dim] = std::max<hsize_t>(unlimited ? chunk_dims[dim] : std::min(chunk_dims[dim], dims[dim]), 1);
+                }
+                else
+                {
+                    chunk[dim] = unlimited ? std::max<hsize_t>(dims[dim], 1024) : dims[dim];
+                }
+            }
+            if (chunking != HDF5_Chunking::Explicit)
+            {
+                // Halve the dimensions in turn until the chunk fits the target size
+                const auto bytes = [&]() { return std::accumulate(chunk.begin(), chunk.end(), static_cast<hsize_t>(typesize), std::multiplies<hsize_t>()); };
+                for (std::size_t dim = 0; bytes() > chunk_target_bytes && std::any_of(chunk.begin(), chunk.end(), [](hsize_t c) { return c > 1; }); dim = (dim + 1) % chunk.size())
+                    chunk[dim] = (chunk[dim] + 1) / 2;
+            }
+            return chunk;
+        }
+
+        ///-------------------------------------------------------------------------------------------------
+        /// <summary>	Sets chunking and filters on a dataset creation property list. </summary>
+        ///-------------------------------------------------------------------------------------------------
+        void apply(hid_t propertylist, const std::vector<hsize_t>& chunk) const
+        {
+            const auto check = [](herr_t err, const char* what) {
+                if (err < 0)
+                    throw std::runtime_error{ std::string{ "Unable to set up the HDF5 " } + what + "!" };
+            };
+            const auto available = [](H5Z_filter_t filter, const char* name) {
+                unsigned int config{ 0 };
+                if (H5Zfilter_avail(filter) <= 0 || H5Zget_filter_info(filter, &config) < 0 || !(config & H5Z_FILTER_CONFIG_ENCODE_ENABLED))
+                    throw std::runtime_error{ std::string{ "The HDF5 library does not provide the " } + name + " filter!" };
+            };
+            check(H5Pset_chunk(propertylist, static_cast<int>(chunk.size()), chunk.data()), "chunking");
+            if (shuffle)
+                check(H5Pset_shuffle(propertylist), "shuffle filter");
+            if (deflate_level > 0)
+            {
+                available(H5Z_FILTER_DEFLATE, "deflate");
+                check(H5Pset_deflate(propertylist, std::min(deflate_level, 9u)), "deflate filter");
+            }
+            if (szip)
+            {
+                available(H5Z_FILTER_SZIP, "szip");
+                check(H5Pset_szip(propertylist, H5_SZIP_NN_OPTION_MASK, szip_pixels_per_block), "szip filter");
+            }
+            if (fletcher32)
+                check(H5Pset_fletcher32(propertylist), "fletcher32 filter");
+        }
+    };
+
     struct HDF5_DatasetOptions : HDF5_GeneralOptions
     {
         hid_t link_creation_propertylist{ H5P_DEFAULT };
         hid_t transfer_propertylist{ H5P_DEFAULT };
+        HDF5_DatasetLayoutOptions layout{};
     };
 
     
@@ -703,7 +804,13 @@ namespace HDF5_Wrapper
                     assert(herr >= 0); // we checked that the link exists so the above should never fail!
 
                     if (oinfo.type == H5O_TYPE_DATASET) {
-                        return HDF5_LocationWrapper(H5Dopen(loc, path.string().c_str(), options.access_propertylist));
+                        const hid_t dataset = H5Dopen(loc, path.string().c_str(), options.access_propertylist);
+                        if (dataset < 0 || static_cast<hid_t>(storeoptions.dataspace) == H5S_ALL || isCompatible(dataset, storeoptions))
+                            return HDF5_LocationWrapper(dataset);
+                        // Shape or type changed (e.g. a resized vector is saved again): replace the dataset
+                        H5Dclose(dataset);
+                        H5Ldelete(loc, path.string().c_str(), H5P_DEFAULT);
+                        return HDF5_LocationWrapper(createDataset(loc, path, options, storeoptions));
                     }
                     else {
                         std::runtime_error{ "Given path is neither empty nor points to a HDF5 Dataset!" };
@@ -712,7 +819,7 @@ namespace HDF5_Wrapper
 
                 }
                 else { // does not exist
-                    return HDF5_LocationWrapper(H5Dcreate(loc, path.string().c_str(), storeoptions.datatype, storeoptions.dataspace, options.link_creation_propertylist, options.creation_propertylist, options.access_propertylist));
+                    return HDF5_LocationWrapper(createDataset(loc, path, options, storeoptions));
                 }
             }
             default:
@@ -720,6 +827,43 @@ namespace HDF5_Wrapper
             }
         };
 
+        //Creates the dataset; chunking and filters are added to the creation property list if requested
+        static hid_t createDataset(const HDF5_LocationWrapper& loc, const hdf5path& path, const HDF5_Options_t<ThisClass>& options, const HDF5_StorageOptions& storeoptions)
+        {
+            const hid_t space = storeoptions.dataspace;
+            if (!options.layout.isChunked() || space == H5S_ALL || H5Sget_simple_extent_type(space) != H5S_SIMPLE)
+                return H5Dcreate(loc, path.string().c_str(), storeoptions.datatype, space, options.link_creation_propertylist, options.creation_propertylist, options.access_propertylist);
+
+            const auto rank = static_cast<std::size_t>(H5Sget_simple_extent_ndims(space));
+            std::vector<hsize_t> dims(rank), maxdims(rank);
+            H5Sget_simple_extent_dims(space, dims.data(), maxdims.data());
+            const auto chunk = options.layout.getChunkDimensions(dims, maxdims, storeoptions.datatype.getSize());
+            if (chunk.empty()) // Empty datasets stay contiguous
+                return H5Dcreate(loc, path.string().c_str(), storeoptions.datatype, space, options.link_creation_propertylist, options.creation_propertylist, options.access_propertylist);
+
+            struct PropertyList {
+                hid_t id;
+                ~PropertyList() { if (id >= 0) H5Pclose(id); }
+            } propertylist{ options.creation_propertylist == H5P_DEFAULT ? H5Pcreate(H5P_DATASET_CREATE) : H5Pcopy(options.creation_propertylist) };
+            if (propertylist.id < 0)
+                throw std::runtime_error{ "Unable to create HDF5 dataset creation property list!" };
+            options.layout.apply(propertylist.id, chunk);
+            const hid_t dataset = H5Dcreate(loc, path.string().c_str(), storeoptions.datatype, space, options.link_creation_propertylist, propertylist.id, options.access_propertylist);
+            if (dataset < 0) // e.g. szip with chunks smaller than a block
+                throw std::runtime_error{ "Unable to create HDF5 dataset '" + path.string() + "' with the requested chunking and filters!" };
+            return dataset;
+        }
+
+        static bool isCompatible(hid_t dataset, const HDF5_StorageOptions& storeoptions) noexcept
+        {
+            const hid_t space = H5Dget_space(dataset);
+            const hid_t type = H5Dget_type(dataset);
+            const bool compatible = H5Sextent_equal(space, storeoptions.dataspace) > 0 && H5Tequal(type, storeoptions.datatype) > 0;
+            H5Tclose(type);
+            H5Sclose(space);
+            return compatible;
+        }
+
     public:
         //template<typename U>
         //HDF5_DatasetWrapper(const HDF5_GeneralType<U>& loc, const hdf5path& path, const HDF5_StorageOptions& storeoptions, HDF5_Options_t<ThisClass> options = HDF5_Options_t<ThisClass>{}) :
@@ -736,7 +880,7 @@ namespace HDF5_Wrapper
         {
             if constexpr(stdext::is_memory_sequentiel_container_v<std::decay_t<T>>)
             {
-                return H5Dwrite(*this, memopts.datatype, memopts.dataspace, storespace, mOptions.transfer_propertylist, &val[0]);
+                return H5Dwrite(*this, memopts.datatype, memopts.dataspace, storespace, mOptions.transfer_propertylist, val.data());
             }
             else
             {
@@ -744,6 +888,13 @@ namespace HDF5_Wrapper
             }
         }
 
+        //Writes the elements of a buffer described by the memory options (no copy)
+        template<typename T>
+        auto writeBuffer(const T* val, const HDF5_MemoryOptions& memopts = HDF5_MemoryOptions{}, const HDF5_DataspaceWrapper& storespace = HDF5_DataspaceWrapper{}) const
+        {
+            return H5Dwrite(*this, memopts.datatype, memopts.dataspace, storespace, mOptions.transfer_propertylist, val);
+        }
+
         template<typename T>
         auto readData(T& val, const HDF5_MemoryOptions& memopts = HDF5_MemoryOptions{}, const HDF5_DataspaceWrapper& storespace = HDF5_DataspaceWrapper{}) const
         {
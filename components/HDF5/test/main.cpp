@@ -0,0 +1,400 @@
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <set>
+#include <vector>
+
+#include <hdf5.h>
+#include <Eigen/Core>
+
+#include <SerAr/Core/Columnar.h>
+#include <SerAr/Core/NamedValue.h>
+#include <SerAr/Core/SizeEstimate_OutputArchive.h>
+#include <SerAr/HDF5/HDF5_Archive.h>
+
+static bool hasAttribute(const std::filesystem::path& path, const char* name, const char* attribute)
+{
+    const hid_t file = H5Fopen(path.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset = H5Dopen(file, name, H5P_DEFAULT);
+    const bool exists = H5Aexists(dataset, attribute) > 0;
+    H5Dclose(dataset);
+    H5Fclose(file);
+    return exists;
+}
+
+// Group of many small datasets
+struct manyvalues {
+    std::array<double, 100> values{};
+};
+template<SerAr::IsArchive Archive>
+void serialize(manyvalues& val, Archive& ar)
+{
+    for (std::size_t i = 0; i < val.values.size(); ++i)
+        ar(Archives::createNamedValue("value" + std::to_string(i), val.values[i]));
+}
+
+// Stored as one dataset per field with Archives::createColumnar
+struct point {
+    double x{ 0 };
+    int y{ 0 };
+};
+template<SerAr::IsArchive Archive>
+void serialize(point& val, Archive& ar)
+{
+    ar(Archives::createNamedValue("x", val.x));
+    ar(Archives::createNamedValue("y", val.y));
+}
+
+// Number of links in a group; -1 if it does not exist
+static long long groupLinks(const std::filesystem::path& path, const char* name)
+{
+    const hid_t file = H5Fopen(path.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t group = H5Gopen(file, name, H5P_DEFAULT);
+    long long links{ -1 };
+    H5G_info_t info{};
+    if (group >= 0 && H5Gget_info(group, &info) >= 0)
+        links = static_cast<long long>(info.nlinks);
+    if (group >= 0)
+        H5Gclose(group);
+    H5Fclose(file);
+    return links;
+}
+
+// Extent of a dataset in the file; empty if it does not exist
+static std::vector<hsize_t> datasetExtent(const std::filesystem::path& path, const char* name)
+{
+    std::vector<hsize_t> dims;
+    const hid_t file = H5Fopen(path.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset = H5Dopen(file, name, H5P_DEFAULT);
+    if (dataset >= 0) {
+        const hid_t space = H5Dget_space(dataset);
+        dims.resize(static_cast<std::size_t>(H5Sget_simple_extent_ndims(space)));
+        H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+        H5Sclose(space);
+        H5Dclose(dataset);
+    }
+    H5Fclose(file);
+    return dims;
+}
+
+// Storage layout, chunk shape and number of filters of a dataset
+struct DatasetLayout {
+    H5D_layout_t layout{ H5D_LAYOUT_ERROR };
+    std::vector<hsize_t> chunk{};
+    int filters{ 0 };
+};
+
+static DatasetLayout datasetLayout(const std::filesystem::path& path, const char* name)
+{
+    DatasetLayout result;
+    const hid_t file = H5Fopen(path.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset = H5Dopen(file, name, H5P_DEFAULT);
+    const hid_t plist = H5Dget_create_plist(dataset);
+    result.layout = H5Pget_layout(plist);
+    if (result.layout == H5D_CHUNKED) {
+        result.chunk.resize(8);
+        result.chunk.resize(static_cast<std::size_t>(H5Pget_chunk(plist, static_cast<int>(result.chunk.size()), result.chunk.data())));
+    }
+    result.filters = H5Pget_nfilters(plist);
+    H5Pclose(plist);
+    H5Dclose(dataset);
+    H5Fclose(file);
+    return result;
+}
+
+// Size of the stored string type; 0 for variable-length strings
+static std::size_t stringTypeSize(const std::filesystem::path& path, const char* name)
+{
+    const hid_t file = H5Fopen(path.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset = H5Dopen(file, name, H5P_DEFAULT);
+    const hid_t type = H5Dget_type(dataset);
+    const std::size_t size = H5Tis_variable_str(type) > 0 ? 0 : H5Tget_size(type);
+    H5Tclose(type);
+    H5Dclose(dataset);
+    H5Fclose(file);
+    return size;
+}
+
+template<typename T>
+static std::vector<T> readDataset(const std::filesystem::path& path, const char* name, hid_t memorytype)
+{
+    std::vector<T> values;
+    const hid_t file = H5Fopen(path.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset = H5Dopen(file, name, H5P_DEFAULT);
+    const hid_t space = H5Dget_space(dataset);
+    values.resize(static_cast<std::size_t>(H5Sget_simple_extent_npoints(space)));
+    H5Dread(dataset, memorytype, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+    H5Sclose(space);
+    H5Dclose(dataset);
+    H5Fclose(file);
+    return values;
+}
+
+int main()
+{
+    using Archive = Archives::HDF5_OutputArchive;
+    using ArchiveRead = Archives::HDF5_InputArchive;
+    std::filesystem::path path{ "test.h5" };
+    {
+        // More records than buffered at once; the second archive continues the datasets of the first
+        Archives::HDF5_OutputOptions options{};
+        options.AppendBufferRecords = 4;
+        const auto appendRecords = [&](int begin, int end) {
+            Archive ar{ path, options };
+            for (int i = begin; i < end; ++i) {
+                ar.append(Archives::createNamedValue("scalar", static_cast<double>(i)));
+                ar.append(Archives::createNamedValue("record", std::vector<int>{ i, -i }));
+                ar.beginGroup("group");
+                ar.append(Archives::createNamedValue("scalar", i * 2));
+                ar.endGroup();
+            }
+            try {
+                ar.append(Archives::createNamedValue("scalar", 1.0f));
+                return false;
+            }
+            catch (const std::runtime_error&) { // Type differs from the previous records
+            }
+            return true;
+        };
+        if (!appendRecords(0, 10))
+            return 1;
+        options.FileCreationMode = HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode::OpenOrCreate;
+        if (!appendRecords(10, 15))
+            return 1;
+
+        if (datasetExtent(path, "scalar") != std::vector<hsize_t>{ 15 } || datasetExtent(path, "record") != std::vector<hsize_t>{ 15, 2 }
+            || datasetExtent(path, "group/scalar") != std::vector<hsize_t>{ 15 })
+            return 1;
+        const auto scalars = readDataset<double>(path, "scalar", H5T_NATIVE_DOUBLE);
+        const auto records = readDataset<int>(path, "record", H5T_NATIVE_INT);
+        const auto groupscalars = readDataset<int>(path, "group/scalar", H5T_NATIVE_INT);
+        for (int i = 0; i < 15; ++i) {
+            const auto index = static_cast<std::size_t>(i);
+            if (scalars[index] != i || records[2 * index] != i || records[2 * index + 1] != -i || groupscalars[index] != 2 * i)
+                return 1;
+        }
+
+        ArchiveRead ar{ path, Archives::HDF5_InputOptions{} };
+        std::vector<double> loaded;
+        ar(Archives::createNamedValue("scalar", loaded));
+        if (loaded != scalars)
+            return 1;
+    }
+    {
+        // Chunking and filters per dataset and for the whole archive
+        using Layout = HDF5_Wrapper::HDF5_DatasetLayoutOptions;
+        path = "test_layout.h5";
+        std::vector<double> values(10000);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<double>(i % 100);
+        Layout compressed{};
+        compressed.chunking = Layout::HDF5_Chunking::Explicit;
+        compressed.chunk_dims = { 1000 };
+        compressed.shuffle = true;
+        compressed.deflate_level = 6;
+        Archives::HDF5_OutputOptions options{};
+        options.DefaultDatasetLayoutOptions.fletcher32 = true;
+        {
+            Archive ar{ path, options };
+            ar(Archives::createNamedValueWithLayout("compressed", values, compressed));
+            ar(Archives::createNamedValueWithLayout("plain", values, Layout{}));
+            ar(Archives::createNamedValue("checksummed", values));
+        }
+        const auto compressedLayout = datasetLayout(path, "compressed");
+        if (compressedLayout.layout != H5D_CHUNKED || compressedLayout.chunk != std::vector<hsize_t>{ 1000 } || compressedLayout.filters != 2)
+            return 1;
+        if (datasetLayout(path, "plain").layout == H5D_CHUNKED || datasetLayout(path, "plain").filters != 0)
+            return 1;
+        // Filters without chunking get an automatic chunk shape (the whole dataset fits the target size)
+        const auto checksummedLayout = datasetLayout(path, "checksummed");
+        if (checksummedLayout.layout != H5D_CHUNKED || checksummedLayout.chunk != std::vector<hsize_t>{ values.size() } || checksummedLayout.filters != 1)
+            return 1;
+
+        ArchiveRead ar{ path, Archives::HDF5_InputOptions{} };
+        for (const char* name : { "compressed", "plain", "checksummed" }) {
+            std::vector<double> loaded;
+            ar(Archives::createNamedValue(name, loaded));
+            if (loaded != values)
+                return 1;
+        }
+    }
+    {
+        // Containers of strings with fixed and variable length; both are loaded the same way
+        path = "test_strings.h5";
+        const std::vector<std::string> strings{ "first", "", "a somewhat longer string", "x" };
+        for (const bool fixed : { true, false }) {
+            Archives::HDF5_OutputOptions options{};
+            options.FixedLengthStrings = fixed;
+            {
+                Archive ar{ path, options };
+                ar(Archives::createNamedValue("strings", strings));
+                ar(Archives::createNamedValue("empty", std::vector<std::string>{}));
+            }
+            if (stringTypeSize(path, "strings") != (fixed ? strings[2].size() : 0))
+                return 1;
+            ArchiveRead ar{ path, Archives::HDF5_InputOptions{} };
+            std::vector<std::string> loaded{ "stale" };
+            ar(Archives::createNamedValue("strings", loaded));
+            if (loaded != strings)
+                return 1;
+            ar(Archives::createNamedValue("empty", loaded));
+            if (!loaded.empty())
+                return 1;
+        }
+    }
+    {
+        // Non-contiguous containers go through the staging buffer; it holds fewer elements than the containers
+        path = "test_staged.h5";
+        std::list<double> list;
+        std::set<int> set;
+        for (int i = 0; i < 11; ++i) {
+            list.push_back(i * 0.5);
+            set.insert(100 - 7 * i);
+        }
+        const std::vector<double> listvalues(list.begin(), list.end());
+        const std::vector<int> setvalues(set.begin(), set.end());
+        {
+            Archives::HDF5_OutputOptions options{};
+            options.StagingBufferBytes = 3 * sizeof(double);
+            Archive ar{ path, options };
+            ar(Archives::createNamedValue("list", list));
+            ar(Archives::createNamedValue("set", set));
+            ar(Archives::createNamedValue("emptylist", std::list<double>{}));
+            ar(Archives::createNamedValue("emptyvector", std::vector<double>{}));
+        }
+        if (readDataset<double>(path, "list", H5T_NATIVE_DOUBLE) != listvalues || readDataset<int>(path, "set", H5T_NATIVE_INT) != setvalues)
+            return 1;
+
+        Archives::HDF5_InputOptions options{};
+        options.StagingBufferBytes = 2 * sizeof(double);
+        ArchiveRead ar{ path, options };
+        std::list<double> loadedlist{ -1.0 };
+        std::set<int> loadedset{ -1 };
+        ar(Archives::createNamedValue("list", loadedlist));
+        ar(Archives::createNamedValue("set", loadedset));
+        if (loadedlist != list || loadedset != set)
+            return 1;
+        std::vector<double> loadedvector{ -1.0 };
+        ar(Archives::createNamedValue("emptylist", loadedlist));
+        ar(Archives::createNamedValue("emptyvector", loadedvector));
+        if (!loadedlist.empty() || !loadedvector.empty())
+            return 1;
+    }
+    {
+        // Column-major matrices are stored as they are in memory with swapped dimensions; row-major ones and
+        // those written with dontReorderData keep their own dimensions. All load into either storage order.
+        using RowMajor = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+        path = "test_matrix.h5";
+        Eigen::MatrixXd matrix(3, 4);
+        for (Eigen::Index row = 0; row < matrix.rows(); ++row)
+            for (Eigen::Index col = 0; col < matrix.cols(); ++col)
+                matrix(row, col) = static_cast<double>(10 * row + col);
+        const RowMajor rowmajor = matrix;
+        const std::vector<double> colmajordata(matrix.data(), matrix.data() + matrix.size());
+        const std::vector<double> rowmajordata(rowmajor.data(), rowmajor.data() + rowmajor.size());
+        {
+            Archive ar{ path };
+            ar(Archives::createNamedValue("colmajor", matrix));
+            ar(Archives::createNamedValue("rowmajor", rowmajor));
+        }
+        {
+            Archives::HDF5_OutputOptions options{};
+            options.FileCreationMode = HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode::OpenOrCreate;
+            options.dontReorderData = true;
+            Archive ar{ path, options };
+            ar(Archives::createNamedValue("reordered", matrix));
+        }
+        {
+            // Written by older versions: row-major layout without the attribute
+            const hid_t file = H5Fopen(path.string().c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+            const hsize_t dims[2]{ 3, 4 };
+            const hid_t space = H5Screate_simple(2, dims, nullptr);
+            const hid_t dataset = H5Dcreate2(file, "legacy", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, rowmajordata.data());
+            H5Dclose(dataset);
+            H5Sclose(space);
+            H5Fclose(file);
+        }
+        if (datasetExtent(path, "colmajor") != std::vector<hsize_t>{ 4, 3 } || !hasAttribute(path, "colmajor", "ColumnMajor")
+            || readDataset<double>(path, "colmajor", H5T_NATIVE_DOUBLE) != colmajordata)
+            return 1;
+        for (const char* name : { "rowmajor", "reordered" }) {
+            if (datasetExtent(path, name) != std::vector<hsize_t>{ 3, 4 } || hasAttribute(path, name, "ColumnMajor")
+                || readDataset<double>(path, name, H5T_NATIVE_DOUBLE) != rowmajordata)
+                return 1;
+        }
+
+        // Differing storage orders are transposed through a staging buffer smaller than the matrix
+        Archives::HDF5_InputOptions options{};
+        options.StagingBufferBytes = 5 * sizeof(double);
+        ArchiveRead ar{ path, options };
+        for (const char* name : { "colmajor", "rowmajor", "reordered", "legacy" }) {
+            Eigen::MatrixXd loaded;
+            RowMajor loadedrowmajor;
+            Eigen::Matrix<double, 3, 4> loadedfixed;
+            ar(Archives::createNamedValue(name, loaded));
+            ar(Archives::createNamedValue(name, loadedrowmajor));
+            ar(Archives::createNamedValue(name, loadedfixed));
+            if (loaded != matrix || loadedrowmajor != rowmajor || loadedfixed != matrix)
+                return 1;
+        }
+        try {
+            Eigen::Matrix<double, 4, 3> transposed;
+            ar(Archives::createNamedValue("colmajor", transposed));
+            return 1;
+        }
+        catch (const std::runtime_error&) { // Stored dimensions do not fit
+        }
+    }
+    {
+        // A dry run sizes the metadata blocks for all groups and datasets
+        path = "test_estimate.h5";
+        manyvalues values{};
+        for (std::size_t i = 0; i < values.values.size(); ++i)
+            values.values[i] = static_cast<double>(i);
+        Archives::SizeEstimate_OutputArchive estimate{};
+        estimate(Archives::createNamedValue("group", values));
+        Archives::HDF5_OutputOptions options{};
+        options.useSizeEstimate(estimate.getEstimate());
+        if (options.MetadataBlockBytes <= 2048)
+            return 1;
+        {
+            Archive ar{ path, options };
+            ar(Archives::createNamedValue("group", values));
+        }
+        if (readDataset<double>(path, "group/value42", H5T_NATIVE_DOUBLE) != std::vector<double>{ 42.0 })
+            return 1;
+    }
+    {
+        // Columnar containers: one dataset per field instead of one group per element
+        path = "test_columnar.h5";
+        std::vector<point> points(50);
+        for (std::size_t i = 0; i < points.size(); ++i)
+            points[i] = point{ 0.5 * static_cast<double>(i), -static_cast<int>(i) };
+        std::vector<point> none;
+        {
+            Archive ar{ path };
+            ar(Archives::createNamedValue("v", Archives::createColumnar(points)));
+            ar(Archives::createNamedValue("none", Archives::createColumnar(none)));
+        }
+        if (groupLinks(path, "v") != 2 || datasetExtent(path, "v/x") != std::vector<hsize_t>{ points.size() }
+            || datasetExtent(path, "v/y") != std::vector<hsize_t>{ points.size() })
+            return 1;
+        std::vector<point> loaded;
+        std::vector<point> empty(2);
+        ArchiveRead ar{ path, Archives::HDF5_InputOptions{} };
+        ar(Archives::createNamedValue("v", Archives::createColumnar(loaded)));
+        ar(Archives::createNamedValue("none", Archives::createColumnar(empty)));
+        if (loaded.size() != points.size() || !empty.empty())
+            return 1;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (loaded[i].x != points[i].x || loaded[i].y != points[i].y)
+                return 1;
+        }
+    }
+    return 0;
+}
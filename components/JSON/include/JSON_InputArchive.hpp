@@ -1,16 +1,23 @@
 #pragma once
 
 #include <filesystem>
+#include <span>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <concepts>
 #include <type_traits>
 //#include <source_location>
 #include <MyCEL/stdext/is_container.h>
 #include <MyCEL/stdext/is_eigen3_type.h>
 
+#include <SerAr/Core/ArrayView.h>
 #include <SerAr/Core/NamedValue.h>
 #include <SerAr/Core/NamedValueWithDesc.h>
+#include <SerAr/Core/Deferred.h>
 #include <SerAr/Core/InputArchive.h>
+#include <SerAr/Core/LoadConstructor.h>
 
 #include <nlohmann/json.hpp>
 
@@ -28,7 +35,7 @@ namespace SerAr
 {
     using namespace Archives;
     using JSONType = typename nlohmann::json;
-    using JSONPointerType = typename nlohmann::json_pointer<JSONType>;
+    using JSONPointerType = typename JSONType::json_pointer; // json_pointer<string_t>; the json_pointer<basic_json> overloads are deprecated
 
     namespace JSON::detail {
 
@@ -38,10 +45,10 @@ namespace SerAr
         };
 
         template<typename Json, typename T>
-        concept InputNamedValueJSONLoadable = IsJSONLoadable<Json, T> && IsNamedValue<T>;
+        concept InputNamedValueJSONLoadable = IsJSONLoadable<Json, T> && IsNamedValue<T> && !IsNamedArrayView<T>;
 
         template<typename Json, typename T>
-        concept InputNamedValueJSONNotLoadable = !IsJSONLoadable<Json, T> && IsNamedValue<T>;
+        concept InputNamedValueJSONNotLoadable = !IsJSONLoadable<Json, T> && IsNamedValue<T> && !IsNamedArrayView<T>;
     }
 
 
@@ -53,6 +60,24 @@ namespace SerAr
         friend class InputArchive<JSON_InputArchive>;
         using ThisClass = JSON_InputArchive;
 
+        // Moves the current position to a location until destroyed
+        struct RestorePointer {
+            JSONPointerType& current;
+            JSONPointerType previous;
+            RestorePointer(JSONPointerType& pointer, JSONPointerType location) : current(pointer), previous(std::exchange(pointer, std::move(location))) {}
+            ~RestorePointer() { current = std::move(previous); }
+            RestorePointer(const RestorePointer&) = delete;
+            RestorePointer& operator=(const RestorePointer&) = delete;
+        };
+        // Appends a reference token to the current position until destroyed; a failed load leaves the position intact
+        struct EnterToken {
+            JSONPointerType& current;
+            EnterToken(JSONPointerType& pointer, std::string token) : current(pointer) { current.push_back(std::move(token)); }
+            ~EnterToken() { current.pop_back(); }
+            EnterToken(const EnterToken&) = delete;
+            EnterToken& operator=(const EnterToken&) = delete;
+        };
+
     public:
         using Options = JSON_InputArchive_Options;
 
@@ -68,38 +93,65 @@ namespace SerAr
         inline ThisClass& load(T&& nval)
         {
             using Type = std::remove_cvref_t<typename std::remove_cvref_t<T>::type>;
-            json_pointer.push_back(nval.name);
-            nval.val = json[json_pointer].get<Type>();
-            json_pointer.pop_back();
+            EnterToken member{ json_pointer, std::string{ nval.getName() } };
+            nval.getValue() = json[json_pointer].get<Type>();
             return *this;
         }
         template<typename T> 
         requires (JSON::detail::InputNamedValueJSONNotLoadable<JSONType, T>)
         inline ThisClass& load(T&& nval)
         {
-            json_pointer.push_back(nval.name);
-            this->operator()(nval.val);
+            EnterToken member{ json_pointer, std::string{ nval.getName() } };
+            this->operator()(nval.getValue());
+            return *this;
+        }
+        // Only records the JSON pointer. The value is converted on first access of the Deferred.
+        template<typename T>
+        inline ThisClass& load(NamedValue<Deferred<T>&>& nval)
+        {
+            json_pointer.push_back(std::string{ nval.getName() });
+            auto location = json_pointer.to_string();
             json_pointer.pop_back();
+            nval.getValue().setLoader(std::move(location), [this](std::string_view loc, T& target) { loadAt(JSONPointerType{ std::string{ loc } }, target); });
+            return *this;
+        }
+        // Views (std::span/std::mdspan) are filled element by element; the (nested) arrays must fit the extents of the view
+        template<typename T>
+        requires (IsNamedArrayView<T>)
+        inline ThisClass& load(T&& nval)
+        {
+            const auto data = arrayViewData(nval.getValue());
+            static_assert(!std::is_const_v<typename decltype(data)::element_type>, "Cannot load into a view of const elements!");
+            const auto extents = arrayViewExtents(nval.getValue());
+            auto pointer = json_pointer;
+            pointer.push_back(std::string{ nval.getName() });
+            if (!json.contains(pointer)) {
+                const auto msg = fmt::format("Error: JSON member at '{}' does not exist!", pointer.to_string());
+                throw std::runtime_error{ msg };
+            }
+            auto position = data.begin();
+            loadArrayView(json[pointer], pointer, position, extents);
             return *this;
         }
+        // Elements are constructed in the container by LoadConstructor (load constructor, factory or default construction)
         template<typename T> 
         requires (!JSON::detail::IsJSONLoadable<JSONType, T>
                   && stdext::is_container_v<std::remove_cvref_t<T>>
-                  && std::default_initializable<typename std::remove_cvref_t<T>::value_type>)
+                  && LoadConstructor<typename std::remove_cvref_t<T>::value_type>::template is_constructible_v<JSON_InputArchive>)
         inline ThisClass& load(T&& value)
         {
             using Container = std::remove_cvref_t<T>;
-            Container ret;
-            typename Container::value_type tmp{};
             if (!json[json_pointer].is_array()) {
                 const auto msg = fmt::format("Error: JSON member at '{}' is not an array!", json_pointer.to_string());
                 throw std::runtime_error{ msg };
             }
-            for (std::size_t i = 0; i < json[json_pointer].size(); i++) {
-                json_pointer.push_back(fmt::format_int(i).c_str());
-                this->operator()(tmp);
-                ret.push_back(std::move(tmp));
-                json_pointer.pop_back();
+            const auto size = json[json_pointer].size();
+            Container ret;
+            if constexpr (requires { ret.reserve(size); })
+                ret.reserve(size);
+            for (std::size_t i = 0; i < size; i++) {
+                EnterToken element{ json_pointer, fmt::format_int(i).c_str() };
+                LoadConstructor<typename Container::value_type>::emplace_into(ret, *this);
             }
             value = std::move(ret);
             return *this;
@@ -119,28 +171,114 @@ namespace SerAr
                 const auto rows = json[json_pointer].size();
                 for (std::size_t i = 0; i < rows; ++i)
                 {
-                    json_pointer.push_back(fmt::format_int(i).c_str());
+                    EnterToken row{ json_pointer, fmt::format_int(i).c_str() };
                     auto tmp = json[json_pointer].get<decltype(res)>();
-                    json_pointer.pop_back();
                     res.insert(res.end(), tmp.begin(), tmp.end());
                 }
-                if constexpr (T::IsRowMajor)
-                {
-                    value = Eigen::Map< T, Eigen::Unaligned >(res.data(), rows, res.size() / rows);
-                }
-                else
-                {
-                    value = Eigen::Map< T, Eigen::Unaligned, Eigen::Stride<1, T::ColsAtCompileTime>>(res.data(), rows, res.size() / rows);
-                }
-                
+                // The rows are stored one after another; Eigen reorders into the storage order of value
+                using RowMajorType = Eigen::Matrix<DataType, T::RowsAtCompileTime, T::ColsAtCompileTime, Eigen::RowMajor>;
+                const auto cols = rows == 0 ? 0 : res.size() / rows;
+                value = Eigen::Map<const RowMajorType, Eigen::Unaligned>(res.data(), static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(cols));
+
             }
             return *this;
         }
 #endif
+        // Loads a single nested value given by the names of the NamedValues from the root separated by '.'
+        // (e.g. "mytest.mynested.mydouble") without loading the enclosing structs.
+        template<typename T>
+        void load_path(std::string_view path, T& value)
+        {
+            if (path.empty())
+                throw std::runtime_error{ "Empty path given to load_path!" };
+            JSONPointerType pointer{};
+            for (auto pos = path.find('.'); ; pos = path.find('.')) {
+                pointer.push_back(std::string{ path.substr(0, pos) });
+                if (pos == path.npos)
+                    break;
+                path.remove_prefix(pos + 1);
+            }
+            if (!json.contains(pointer)) {
+                const auto msg = fmt::format("Error: JSON member at '{}' does not exist!", pointer.to_string());
+                throw std::runtime_error{ msg };
+            }
+            loadAt(std::move(pointer), value);
+        }
+        // Checks for a member of the given name in the current object (see SerAr::HasFieldLookup)
+        bool contains(std::string_view name) const
+        {
+            if (!json.contains(json_pointer))
+                return false;
+            const auto& current = json[json_pointer];
+            return current.is_object() && current.contains(name);
+        }
+
+        // Shared objects (see SerAr::HasSharedObjectLoad); resolves {"$ref": "#<JSON pointer>"} written by the output archive
+        inline ObjectTracker& objectTracker() noexcept { return tracker; }
+        std::string objectIdentity(std::string_view name) const
+        {
+            auto pointer = json_pointer;
+            if (!name.empty())
+                pointer.push_back(std::string{ name });
+            if (!json.contains(pointer)) {
+                const auto msg = fmt::format("Error: JSON member at '{}' does not exist!", pointer.to_string());
+                throw std::runtime_error{ msg };
+            }
+            const auto& value = json[pointer];
+            if (value.is_object() && value.size() == 1 && value.contains("$ref")) {
+                const auto& reference = value["$ref"];
+                if (!reference.is_string() || !reference.get_ref<const std::string&>().starts_with('#')) {
+                    const auto msg = fmt::format("Error: JSON member at '{}' is not a local reference!", pointer.to_string());
+                    throw std::runtime_error{ msg };
+                }
+                return reference.get<std::string>().substr(1);
+            }
+            return pointer.to_string();
+        }
+        // Positions the archive at the stored object of an identity until the returned scope is destroyed
+        // (see SerAr::HasSharedObjectScope); references are resolved even if their target was not loaded before
+        RestorePointer objectScope(const std::string& identity)
+        {
+            JSONPointerType pointer{ identity };
+            if (!json.contains(pointer)) {
+                const auto msg = fmt::format("Error: Referenced JSON member at '{}' does not exist!", identity);
+                throw std::runtime_error{ msg };
+            }
+            return RestorePointer{ json_pointer, std::move(pointer) };
+        }
+
         JSONType json {};
     private:
         const Options options{};
         JSONPointerType json_pointer {};
+        ObjectTracker tracker {};
+
+        // Loads value from the given location. The current position is restored afterwards.
+        template<typename T>
+        void loadAt(JSONPointerType location, T& value)
+        {
+            RestorePointer restore{ json_pointer, std::move(location) };
+            this->operator()(value);
+        }
+
+        template<typename Iterator>
+        static void loadArrayView(const JSONType& current, const JSONPointerType& pointer, Iterator& position, std::span<const std::size_t> extents)
+        {
+            if (extents.empty()) {
+                current.get_to(*position++);
+                return;
+            }
+            if (!current.is_array() || current.size() != extents.front()) {
+                const auto msg = fmt::format("Error: JSON member at '{}' does not fit the extents of the view it is loaded into!", pointer.to_string());
+                throw std::runtime_error{ msg };
+            }
+            for (const auto& element : current) {
+                if (extents.size() == 1)
+                    element.get_to(*position++);
+                else
+                    loadArrayView(element, pointer, position, extents.subspan(1));
+            }
+        }
     };
 
     #define JSON_ARCHIVE_LOAD(type) extern template JSON_InputArchive& JSON_InputArchive::load< NamedValue<type&>& >(NamedValue< type& >&);
@@ -1,16 +1,28 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
 #include <stack>
+#include <string>
+#include <string_view>
 #include <concepts>
 #include <type_traits>
+#include <vector>
 //#include <source_location>
 #include <MyCEL/stdext/is_container.h>
 #include <MyCEL/stdext/is_eigen3_type.h>
 
+#include <SerAr/Core/ArchiveMemoryResource.h>
+#include <SerAr/Core/ArrayView.h>
 #include <SerAr/Core/NamedValue.h>
 #include <SerAr/Core/NamedValueWithDesc.h>
 #include <SerAr/Core/OutputArchive.h>
+#include <SerAr/Core/TaskPool.h>
 
 #include <nlohmann/json.hpp>
 namespace SerAr
@@ -29,6 +41,9 @@ namespace SerAr
     struct JSON_OutputArchive_Options {
         std::streamsize indent_spaces{ 4 };
         std::ios_base::openmode     mode{std::ios::trunc};
+        std::pmr::memory_resource*  memory_resource{ nullptr }; // Stack of open objects and group names; nullptr = arena owned by the archive
+        std::size_t                 threads{ 1 };               // > 1: containers of structs are encoded in parallel (serialize must not modify shared state)
+        std::size_t                 parallel_min_elements{ 256 }; // Smaller containers are always encoded serially
     };
 
     class JSON_OutputArchive : public OutputArchive<JSON_OutputArchive>
@@ -41,6 +56,18 @@ namespace SerAr
 
         JSON_OutputArchive(const Options& opt, const std::filesystem::path& path);
         ~JSON_OutputArchive() noexcept;
+
+        // Writes the current document to the file (replacing an earlier flush); must not be called within a group.
+        // Throws if the file cannot be written. The destructor only writes again if the document changed since.
+        void flush();
+
+        // Every save goes through here; marks the document as changed since the last flush
+        template <typename ... Types>
+        inline ThisClass& operator()(Types&& ... args)
+        {
+            modified = true;
+            return OutputArchive<ThisClass>::operator()(std::forward<Types>(args)...);
+        }
         template<typename T> requires (JSON::detail::IsJSONStoreable<JSONType, T> && !stdext::is_eigen_type_v<std::remove_cvref_t<T>>)
             inline ThisClass& save(const T& value)
         {
@@ -48,35 +75,39 @@ namespace SerAr
             current_json = value;
             return *this;
         }
-        template<typename T> requires (JSON::detail::IsJSONStoreable<JSONType, T>)
+        template<typename T> requires (JSON::detail::IsJSONStoreable<JSONType, T> && !SerAr::IsArrayView<T>)
         inline ThisClass& save(const NamedValue<T>& nval)
         {
             auto& current_json = json_stack.top();
-            current_json[nval.name] = nval.val;
+            current_json[std::string{ nval.getName() }] = nval.getValue(); // JSON objects own their keys
             return *this;
         }
 
         template<typename T> requires (!SerAr::IsTypeSaveable<T, ThisClass> && !stdext::is_eigen_type_v<std::remove_cvref_t<T>> && !JSON::detail::IsJSONStoreable<JSONType, T> && !stdext::is_container_v<std::remove_cvref_t<T>>)
             inline ThisClass& save(const T& value)
         {
+            enterPath(nextIndex());
             json_stack.push(JSONType{});
             this->operator()(value);                // Fill the JSON object
-            const auto current_json = json_stack.top(); // Get filled JSON
+            auto current_json = std::move(json_stack.top()); // Get filled JSON
             json_stack.pop();
+            leavePath();
             auto& parrent_json = json_stack.top();
             parrent_json.push_back(std::move(current_json)); // Insert filled JSON into parrent. 
             return *this;
         }
 
-        template<typename T> requires (!JSON::detail::IsJSONStoreable<JSONType, T> && !stdext::is_container_v<std::remove_cvref_t<T>>)
+        template<typename T> requires (!JSON::detail::IsJSONStoreable<JSONType, T> && !stdext::is_container_v<std::remove_cvref_t<T>> && !SerAr::IsArrayView<T>)
             inline ThisClass& save(const NamedValue<T>& nvalue)
         {
+            enterPath(nvalue.getName());
             json_stack.push(JSONType{});
-            this->operator()(nvalue.val);                // Fill the JSON object
-            const auto current_json = json_stack.top(); // Get filled JSON
+            this->operator()(nvalue.getValue());                // Fill the JSON object
+            auto current_json = std::move(json_stack.top()); // Get filled JSON
             json_stack.pop();
+            leavePath();
             auto& parrent_json = json_stack.top();
-            parrent_json[nvalue.name] = std::move(current_json); // Insert filled JSON into parrent. 
+            parrent_json[std::string{ nvalue.getName() }] = std::move(current_json); // Insert filled JSON into parrent. 
             return *this;
         }
         template<typename T> requires (!JSON::detail::IsJSONStoreable<JSONType, T>
@@ -84,29 +115,38 @@ namespace SerAr
             inline ThisClass& save(const T& value)
         {
             JSONType current_json{};
-            for (const auto& element : value) {
-                json_stack.push(JSONType{});
-                this->operator()(element);                // Fill the JSON object
-                const auto child_json = json_stack.top(); // Get filled JSON
-                json_stack.pop();
-                current_json.push_back(std::move(child_json));
-            }
+            enterPath(nextIndex());
+            saveElements(value, current_json);
+            leavePath();
             auto& parrent_json = json_stack.top();
             parrent_json.push_back(std::move(current_json));
             return *this;
         }
         template<typename T> requires (!JSON::detail::IsJSONStoreable<JSONType, T>
-            && stdext::is_container_v<std::remove_cvref_t<T>>)
+            && stdext::is_container_v<std::remove_cvref_t<T>> && !SerAr::IsArrayView<T>)
             inline ThisClass& save(const NamedValue<T>& value)
         {
             auto& parrent_json = json_stack.top();
-            for (const auto& element : value.val) {
-                json_stack.push(JSONType{});
-                this->operator()(element);                // Fill the JSON object
-                const auto child_json = json_stack.top(); // Get filled JSON
-                json_stack.pop();
-                parrent_json[value.name].push_back(std::move(child_json));
+            if (value.getValue().empty()) {
+                if (parrent_json.is_object())
+                    parrent_json.erase(std::string{ value.getName() }); // Remove a previously saved value
+                return *this;
             }
+            auto& array_json = parrent_json[std::string{ value.getName() }]; // Lookup the key once and not per element
+            array_json = JSONType::array();
+            enterPath(value.getName());
+            saveElements(value.getValue(), array_json);
+            leavePath();
+            return *this;
+        }
+        // Views (std::span/std::mdspan) are written element by element; views of higher rank become nested arrays
+        template<typename T> requires (SerAr::IsArrayView<T>)
+            inline ThisClass& save(const NamedValue<T>& value)
+        {
+            const auto data = arrayViewData(value.getValue());
+            const auto extents = arrayViewExtents(value.getValue());
+            auto position = data.begin();
+            saveArrayView(json_stack.top()[std::string{ value.getName() }], position, extents);
             return *this;
         }
 #ifdef EIGEN_CORE_H
@@ -138,10 +178,128 @@ namespace SerAr
             return *this;
         }
 #endif
+        // Group interface (see SerAr::HasGroupInterface); same as saving a NamedValue holding a struct.
+        // An already saved object of the same name is reopened so that its other keys are kept.
+        inline void beginGroup(std::string_view name)
+        {
+            modified = true;
+            auto& parrent_json = json_stack.top();
+            JSONType current_json{};
+            if (parrent_json.is_object()) {
+                if (auto it = parrent_json.find(name); it != parrent_json.end() && it->is_object())
+                    current_json = std::move(*it);
+            }
+            json_stack.push(std::move(current_json));
+            group_names.emplace(name);
+            enterPath(name);
+        }
+        inline void endGroup()
+        {
+            leavePath();
+            auto current_json = std::move(json_stack.top());
+            json_stack.pop();
+            json_stack.top()[std::string{ group_names.top() }] = std::move(current_json);
+            group_names.pop();
+        }
+
+        // Shared objects (see SerAr::HasSharedObjectSave). Later occurrences are written as
+        // {"$ref": "#<JSON pointer to the first occurrence>"}.
+        inline ObjectTracker& objectTracker() noexcept { return tracker; }
+        std::string objectLocation(std::string_view name) const;
+        void saveObjectReference(std::string_view name, const std::string& location);
     private:
+        // Only builds the JSON document (no file); used to encode parts of a container in parallel
+        explicit JSON_OutputArchive(const Options& opt);
+
+        template<typename Container>
+        void saveElements(const Container& container, JSONType& array_json)
+        {
+            const auto encode = [](ThisClass& ar, const auto& element, std::size_t index) {
+                ar.enterPath(index);
+                ar.json_stack.push(JSONType{});
+                ar(element);                                // Fill the JSON object
+                auto child_json = std::move(ar.json_stack.top()); // Get filled JSON
+                ar.json_stack.pop();
+                ar.leavePath();
+                return child_json;
+            };
+            if constexpr (std::ranges::random_access_range<const Container>) {
+                const auto count = static_cast<std::size_t>(std::ranges::size(container));
+                if (pool && count >= options.parallel_min_elements) {
+                    // Chunks are encoded into their own documents and then appended in order;
+                    // the result is the same as the serial one. Chunks containing shared objects
+                    // cannot be deduplicated against each other; those containers are encoded serially.
+                    const auto chunk_size = std::max<std::size_t>(count / (pool->size() * 8), 1);
+                    std::vector<std::vector<JSONType>> chunks((count + chunk_size - 1) / chunk_size);
+                    std::atomic<bool> shared_objects{ false };
+                    pool->parallel_for(chunks.size(), [&](std::size_t chunk) {
+                        if (shared_objects)
+                            return;
+                        Options chunk_options{ options };
+                        chunk_options.threads = 1;
+                        chunk_options.memory_resource = nullptr; // The resource of the user need not be thread-safe; every chunk uses its own arena
+                        ThisClass ar{ chunk_options };
+                        ar.json_path = json_path;
+                        const auto first = chunk * chunk_size;
+                        const auto last = std::min(first + chunk_size, count);
+                        chunks[chunk].reserve(last - first);
+                        for (auto i = first; i < last; ++i)
+                            chunks[chunk].push_back(encode(ar, std::ranges::begin(container)[static_cast<std::ptrdiff_t>(i)], i));
+                        if (!ar.tracker.empty())
+                            shared_objects = true;
+                    });
+                    if (!shared_objects) {
+                        for (auto& chunk : chunks) {
+                            for (auto& child_json : chunk)
+                                array_json.push_back(std::move(child_json));
+                        }
+                        return;
+                    }
+                }
+            }
+            std::size_t index{ 0 };
+            for (const auto& element : container)
+                array_json.push_back(encode(*this, element, index++));
+        }
+
+        template<typename Iterator>
+        static void saveArrayView(JSONType& json, Iterator& position, std::span<const std::size_t> extents)
+        {
+            if (extents.empty()) {
+                json = *position++;
+                return;
+            }
+            json = JSONType::array();
+            auto& elements = json.get_ref<JSONType::array_t&>();
+            elements.reserve(extents.front());
+            for (std::size_t i = 0; i < extents.front(); ++i) {
+                if (extents.size() == 1)
+                    elements.emplace_back(*position++);
+                else
+                    saveArrayView(elements.emplace_back(), position, extents.subspan(1));
+            }
+        }
+
+        // JSON pointer of the current value (only maintained for objects and arrays)
+        void enterPath(std::string_view name);
+        void enterPath(std::size_t index);
+        inline void leavePath() { json_path.resize(json_path.rfind('/')); }
+        // Index the next value pushed into the current array gets
+        inline std::size_t nextIndex() const { return json_stack.top().is_array() ? json_stack.top().size() : 0; }
+
         const Options options{};
+        const std::filesystem::path filepath;
         std::unique_ptr<std::ofstream> pstr {nullptr};
-        std::stack<JSONType> json_stack;
+        bool written { false };
+        bool modified { false };    // Changed since the last write
+        ArchiveMemoryResource memory { options.memory_resource };
+        pmr_stack<JSONType> json_stack { memory.get() };          // Only the stack; the JSON values themselves use the allocator of JSONType
+        pmr_stack<std::pmr::string> group_names { memory.get() };
+        std::pmr::string json_path { memory.get() };
+        ObjectTracker tracker {};
+        std::unique_ptr<TaskPool> pool { options.threads > 1 ? std::make_unique<TaskPool>(options.threads) : nullptr };
+
+        void write();
     };
 
     #define JSON_ARCHIVE_SAVE(type) extern template JSON_OutputArchive& JSON_OutputArchive::save< type &>(const NamedValue< type &> &);
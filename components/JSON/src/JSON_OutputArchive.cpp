@@ -4,6 +4,7 @@
 
 #include <nlohmann/json.hpp>
 #include <fmt/core.h>
+#include <fmt/format.h>
 
 namespace SerAr {
     using namespace ::Archives;
@@ -15,7 +16,7 @@ namespace SerAr {
     }
 
     JSON_OutputArchive::JSON_OutputArchive(const Options &opt, const std::filesystem::path& path /*, const std::source_location& loc = std::source_location::current()*/)
-        : OutputArchive(this), options(opt)
+        : OutputArchive(this), options(opt), filepath(path)
     {   
         json_stack.push(JSONType{});
         if (!path.has_filename())
@@ -35,14 +36,97 @@ namespace SerAr {
         }
     }
 
+    JSON_OutputArchive::JSON_OutputArchive(const Options &opt)
+        : OutputArchive(this), options(opt)
+    {
+        json_stack.push(JSONType{});
+    }
+
     JSON_OutputArchive::~JSON_OutputArchive() noexcept {
-        assert(json_stack.size()==1);
-        if(json_stack.empty())
+        // A save interrupted by an exception leaves its nested values open; they are incomplete and dropped
+        while (json_stack.size() > 1)
+            json_stack.pop();
+        if(json_stack.empty() || !pstr)
             return;
         
-        *pstr << std::setw(options.indent_spaces) << json_stack.top();
+        try {
+            if (!written || modified) // Keep a flushed document if nothing changed since
+                write();
+        }
+        catch (...) {}
         json_stack.pop();
+    }
+
+    void JSON_OutputArchive::flush()
+    {
+        if (json_stack.size() != 1)
+            throw_runtime_error("Cannot flush while a group or nested value is open!");
+        write();
+    }
+
+    void JSON_OutputArchive::write()
+    {
+        if (written) { // Replace the previously written document
+            pstr->close();
+            pstr->open(filepath.string().c_str(), std::ios::out | std::ios::trunc);
+            if (!pstr->is_open())
+            {
+                const auto msg= fmt::format("Unable to reopen: '{}'",filepath.string());
+                throw_runtime_error(msg);
+            }
+        }
+        *pstr << std::setw(options.indent_spaces) << json_stack.top();
         *pstr << std::flush;
+        if (!*pstr)
+        {
+            const auto msg= fmt::format("Unable to write: '{}'",filepath.string());
+            throw_runtime_error(msg);
+        }
+        written = true;
+        modified = false;
+    }
+
+    // Appends name as reference token of a JSON pointer ('~' and '/' escaped)
+    static void appendPointerToken(std::pmr::string& path, std::string_view name)
+    {
+        path.push_back('/');
+        for (const auto c : name) {
+            if (c == '~')
+                path.append("~0");
+            else if (c == '/')
+                path.append("~1");
+            else
+                path.push_back(c);
+        }
+    }
+
+    void JSON_OutputArchive::enterPath(std::string_view name)
+    {
+        appendPointerToken(json_path, name);
+    }
+
+    void JSON_OutputArchive::enterPath(std::size_t index)
+    {
+        json_path.push_back('/');
+        json_path.append(fmt::format_int(index).c_str());
+    }
+
+    std::string JSON_OutputArchive::objectLocation(std::string_view name) const
+    {
+        std::pmr::string location{ json_path };
+        if (!name.empty())
+            appendPointerToken(location, name);
+        return std::string{ location };
+    }
+
+    void JSON_OutputArchive::saveObjectReference(std::string_view name, const std::string& location)
+    {
+        JSONType reference{ { "$ref", "#" + location } };
+        auto& current_json = json_stack.top();
+        if (name.empty())
+            current_json = std::move(reference);
+        else
+            current_json[std::string{ name }] = std::move(reference);
     }
 
     // void throw_runtime_error(std::string_view msg,const std::source_location& loc = std::source_location::current())
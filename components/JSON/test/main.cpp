@@ -1,11 +1,37 @@
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
 #include <Eigen/Core>
 
+#include <SerAr/Core/Async_OutputArchive.h>
+#include <SerAr/Core/CheckpointWriter.h>
+#include <SerAr/Core/Columnar.h>
+#include <SerAr/Core/Incremental_OutputArchive.h>
+#include <SerAr/Core/LoadConstructor.h>
+#include <SerAr/Core/NamedEnumVariant.hpp>
+#include <SerAr/Core/SizeEstimate_OutputArchive.h>
+#include <SerAr/Core/Tee_OutputArchive.h>
 #include <SerAr/Core/NamedValue.h>
+#include <SerAr/Core/NamedValueWithDefault.h>
 #include <SerAr/JSON/JSON_OutputArchive.hpp>
 #include <SerAr/JSON/JSON_InputArchive.hpp>
 
@@ -37,6 +63,124 @@ void serialize(test& val, Archive& ar) {
     ar(Archives::createNamedValue("myvecnested", val.myvecnested));
 }
 
+// Linked through shared pointers; used to build cycles
+struct node {
+    int value{ 0 };
+    std::shared_ptr<node> next{};
+};
+template<SerAr::IsArchive Archive>
+void serialize(node& val, Archive& ar) {
+    ar(Archives::createNamedValue("value", val.value));
+    ar(Archives::createNamedValue("next", val.next));
+}
+// Same as node but only constructible by its load constructor
+struct loadnode {
+    int value;
+    std::shared_ptr<loadnode> next{};
+    explicit loadnode(int v) : value(v) {}
+    template<SerAr::IsArchive Archive>
+    loadnode(Archives::load_construct_t, Archive& ar) : value(0) {
+        ar(Archives::createNamedValue("value", value));
+        ar(Archives::createNamedValue("next", next));
+    }
+};
+template<SerAr::IsArchive Archive>
+void serialize(loadnode& val, Archive& ar) {
+    ar(Archives::createNamedValue("value", val.value));
+    ar(Archives::createNamedValue("next", val.next));
+}
+// Only constructible from an archive (or explicitly)
+struct loadonly {
+    int value;
+    explicit loadonly(int v) : value(v) {}
+    template<SerAr::IsArchive Archive>
+    loadonly(Archives::load_construct_t, Archive& ar) : value(0) {
+        ar(Archives::createNamedValue("value", value));
+    }
+};
+template<SerAr::IsArchive Archive>
+void serialize(loadonly& val, Archive& ar) {
+    ar(Archives::createNamedValue("value", val.value));
+}
+// Counts the living and all constructed objects to check that a failed load leaves nothing constructed
+// and that containers are loaded without intermediate objects
+struct counted {
+    static inline int alive{ 0 };
+    static inline int constructions{ 0 };
+    int value{ 0 };
+    counted() { ++alive; ++constructions; }
+    counted(const counted& other) : value(other.value) { ++alive; ++constructions; }
+    ~counted() { --alive; }
+};
+template<SerAr::IsArchive Archive>
+void serialize(counted& val, Archive& ar) {
+    ar(Archives::createNamedValue("value", val.value));
+}
+
+// Enum variant listing its enumerators in a constexpr enum_values
+enum class shape { circle, square };
+std::string to_string(shape value) {
+    return value == shape::circle ? "circle" : "square";
+}
+shape from_string(std::string_view str, shape) {
+    if (str == "circle")
+        return shape::circle;
+    if (str == "square")
+        return shape::square;
+    throw std::out_of_range{ "Unknown shape: " + std::string{ str } };
+}
+struct circle { double radius{ 0 }; };
+struct square { double side{ 0 }; };
+template<SerAr::IsArchive Archive>
+void serialize(circle& val, Archive& ar) {
+    ar(Archives::createNamedValue("radius", val.radius));
+}
+template<SerAr::IsArchive Archive>
+void serialize(square& val, Archive& ar) {
+    ar(Archives::createNamedValue("side", val.side));
+}
+template<shape value>
+struct shape_mapping;
+template<>
+struct shape_mapping<shape::circle> { using type = circle; };
+template<>
+struct shape_mapping<shape::square> { using type = square; };
+struct shape_variant {
+    using enum_type = shape;
+    using enum_variant_type = std::variant<circle, square>;
+    template<shape value>
+    using enum_variant_mapping_t = shape_mapping<value>;
+    static constexpr std::array enum_values{ shape::circle, shape::square };
+    shape value{ shape::circle };
+    enum_variant_type variant{};
+};
+
+// Saving it always throws
+struct failing {};
+template<SerAr::IsArchive Archive>
+void serialize(failing&, Archive&) {
+    throw std::runtime_error{ "failing cannot be serialized" };
+}
+
+// Upstream resource which notes allocations from any thread but the one constructing it
+class single_thread_resource final : public std::pmr::memory_resource {
+public:
+    std::atomic<bool> foreign_thread{ false };
+private:
+    const std::thread::id owner{ std::this_thread::get_id() };
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (std::this_thread::get_id() != owner)
+            foreign_thread = true;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
 int main()
 {
     using Archive = Archives::JSON_OutputArchive;
@@ -50,7 +194,14 @@ int main()
     {
         ArchiveRead ar {{},path};
         test mytest {.myint=0};
-        ar(Archives::createNamedValue("mytest",mytest));       
+        ar(Archives::createNamedValue("mytest",mytest));
+    }
+    {
+        ArchiveRead ar {{},path};
+        double mydouble {0};
+        ar.load_path("mytest.mynested.mydouble", mydouble);
+        if (mydouble != othertest{}.mydouble)
+            return 1;
     }
     path = "test3.json";
     {
@@ -96,6 +247,441 @@ int main()
         Eigen::Matrix<double, 3, 2> m;
         ar(m);
     }
+    {
+        std::vector<othertest> many(1000);
+        for (std::size_t i = 0; i < many.size(); ++i)
+            many[i].mydouble = static_cast<double>(i);
+        {
+            Archive ar{ {},"test7.json" };
+            ar(Archives::createNamedValue("many", many));
+        }
+        {
+            Archive ar{ {.threads = 4},"test8.json" };
+            ar(Archives::createNamedValue("many", many));
+        }
+        std::ifstream serial{ "test7.json" };
+        std::ifstream parallel{ "test8.json" };
+        if (!std::equal(std::istreambuf_iterator<char>{ serial }, {}, std::istreambuf_iterator<char>{ parallel }, {}))
+            return 1;        // A memory resource given by the user is only used by the thread of the archive
+        single_thread_resource resource{};
+        {
+            Archive ar{ {.memory_resource = &resource, .threads = 4},"test8.json" };
+            ar(Archives::createNamedValue("many", many));
+        }
+        if (resource.foreign_thread)
+            return 1;
+        serial.clear();
+        serial.seekg(0);
+        std::ifstream withresource{ "test8.json" };
+        if (!std::equal(std::istreambuf_iterator<char>{ serial }, {}, std::istreambuf_iterator<char>{ withresource }, {}))
+            return 1;
+    }
+    path = "test9.json";
+    {
+        auto shared = std::make_shared<othertest>();
+        std::vector<std::shared_ptr<othertest>> tmp{ shared, std::make_shared<othertest>(), shared };
+        Archive ar{ {},path };
+        ar(Archives::createNamedValue("first", shared));
+        ar(Archives::createNamedValue("shared", tmp));
+    }
+    {
+        std::shared_ptr<othertest> first;
+        std::vector<std::shared_ptr<othertest>> tmp;
+        ArchiveRead ar{ {},path };
+        ar(Archives::createNamedValue("first", first));
+        ar(Archives::createNamedValue("shared", tmp));
+        if (tmp.size() != 3 || tmp[0] != first || tmp[2] != first || tmp[1] == first)
+            return 1;
+    }
+    path = "test10.json";
+    {
+        Archive ar{ {},path };
+        ar(Archives::createNamedValue("present", 1));
+    }
+    {
+        int present{ 0 };
+        int missing{ 0 };
+        std::optional<othertest> nothing{ othertest{} };
+        ArchiveRead ar{ {},path };
+        ar(Archives::createNamedValueWithDefault("present", present, 2));
+        ar(Archives::createNamedValueWithDefault("missing", missing, 3));
+        ar(Archives::createNamedValue("nothing", nothing));
+        if (present != 1 || missing != 3 || nothing.has_value())
+            return 1;
+    }
+    path = "test11.json";
+    {
+        const std::vector values{ 1.5, 2.5, 3.5 };
+        Archive ar{ {},path };
+        ar(Archives::createNamedValue("view", std::span{ values }));
+    }
+    {
+        std::vector<double> values(3);
+        ArchiveRead ar{ {},path };
+        ar(Archives::createNamedValue("view", std::span{ values }));
+        if (values != std::vector{ 1.5, 2.5, 3.5 })
+            return 1;
+    }
+    path = "test12.json";
+    {
+        std::vector<othertest> many(3);
+        for (std::size_t i = 0; i < many.size(); ++i)
+            many[i].mydouble = static_cast<double>(i);
+        std::vector<othertest> none;
+        {
+            Archive ar{ {},path };
+            ar(Archives::createNamedValue("many", Archives::createColumnar(many)));
+            ar(Archives::createNamedValue("none", Archives::createColumnar(none)));
+        }
+        std::vector<othertest> loaded;
+        std::vector<othertest> empty(2);
+        {
+            ArchiveRead ar{ {},path };
+            ar(Archives::createNamedValue("many", Archives::createColumnar(loaded)));
+            ar(Archives::createNamedValue("none", Archives::createColumnar(empty)));
+        }
+        if (loaded.size() != many.size() || !empty.empty())
+            return 1;
+        for (std::size_t i = 0; i < many.size(); ++i) {
+            if (loaded[i].mydouble != many[i].mydouble || loaded[i].myvector != many[i].myvector)
+                return 1;
+        }
+    }
+    path = "test13.json";
+    {
+        std::filesystem::remove("test13.json.manifest"); // Start without checkpoints of a previous run
+        Archives::CheckpointWriter<Archive> writer{ path };
+        for (std::uint64_t i = 1; i <= 3; ++i) {
+            othertest value{};
+            value.mydouble = static_cast<double>(i);
+            if (writer.write(Archives::createNamedValue("value", value)) != i)
+                return 1;
+        }
+        othertest restored{};
+        if (Archives::restoreCheckpoint<ArchiveRead>(path, {}, Archives::createNamedValue("value", restored)) != 3u || restored.mydouble != 3.0)
+            return 1;
+        // With two slots the third checkpoint is in slot 0; if it is corrupt the second one is restored
+        std::ofstream{ writer.slotPath(0), std::ios::trunc } << "{ \"value\": ";
+        if (Archives::restoreCheckpoint<ArchiveRead>(path, {}, Archives::createNamedValue("value", restored)) != 2u || restored.mydouble != 2.0)
+            return 1;
+    }
+    path = "test 13.json";
+    {
+        // File names with spaces; a new writer continues with the slots listed in the manifest
+        std::filesystem::remove("test 13.json.manifest");
+        for (std::uint64_t i = 1; i <= 3; ++i) {
+            Archives::CheckpointWriter<Archive> writer{ path };
+            othertest value{};
+            value.mydouble = static_cast<double>(i);
+            if (writer.write(Archives::createNamedValue("value", value)) != i)
+                return 1;
+        }
+        othertest restored{};
+        if (Archives::restoreCheckpoint<ArchiveRead>(path, {}, Archives::createNamedValue("value", restored)) != 3u || restored.mydouble != 3.0)
+            return 1;
+    }
+    path = "test14.json";
+    {
+        auto ring = std::make_shared<node>(1);
+        ring->next = std::make_shared<node>(2);
+        ring->next->next = ring;
+        auto loadring = std::make_shared<loadnode>(1);
+        loadring->next = std::make_shared<loadnode>(2);
+        loadring->next->next = loadring;
+        {
+            Archive ar{ {},path };
+            ar(Archives::createNamedValue("ring", ring));
+            ar(Archives::createNamedValue("loadring", loadring));
+        }
+        ring->next->next.reset();
+        loadring->next->next.reset();
+    }
+    {
+        std::shared_ptr<node> ring;
+        std::shared_ptr<loadnode> loadring;
+        {
+            ArchiveRead ar{ {},path };
+            ar(Archives::createNamedValue("ring", ring));
+            ar(Archives::createNamedValue("loadring", loadring));
+        }
+        const bool closed = ring && ring->value == 1 && ring->next && ring->next->value == 2 && ring->next->next == ring
+                            && loadring && loadring->value == 1 && loadring->next && loadring->next->value == 2 && loadring->next->next == loadring;
+        if (ring && ring->next)
+            ring->next->next.reset();
+        if (loadring && loadring->next)
+            loadring->next->next.reset();
+        if (!closed)
+            return 1;
+    }
+    path = "test24.json";
+    {
+        {
+            Archive ar{ {},path };
+            // A new object at the address of a released one is no reference to it
+            const auto selfloop = [](int value) {
+                auto looped = std::make_shared<node>(value);
+                looped->next = looped;
+                return looped;
+            };
+            auto first = selfloop(1);
+            ar(Archives::createNamedValue("first", first));
+            first->next.reset();
+            first.reset();
+            auto second = selfloop(2);
+            ar(Archives::createNamedValue("second", second));
+            second->next.reset();
+            // Neither is a member at the address of its struct
+            auto third = selfloop(3);
+            std::shared_ptr<int> member{ third, &third->value };
+            ar(Archives::createNamedValue("third", third));
+            ar(Archives::createNamedValue("member", member));
+            ar(Archives::createNamedValue("alias", third));
+            third->next.reset();
+        }
+        // The reference is loaded first; its target is loaded from where it is stored
+        std::shared_ptr<node> alias, third, second;
+        std::shared_ptr<int> member;
+        ArchiveRead ar{ {},path };
+        ar(Archives::createNamedValue("alias", alias));
+        ar(Archives::createNamedValue("third", third));
+        ar(Archives::createNamedValue("second", second));
+        ar(Archives::createNamedValue("member", member));
+        const bool resolved = alias && alias->value == 3 && alias == third && alias->next == alias && second && second->value == 2
+                              && second->next == second && member && *member == 3;
+        for (auto* looped : { &alias, &second })
+            if (*looped)
+                (*looped)->next.reset();
+        if (!resolved)
+            return 1;
+    }
+    path = "test15.json";
+    {
+        Archives::Async_OutputArchive<Archive> ar{ {}, Archive::Options{}, path };
+        test mytest;
+        mytest.myint = 42;
+        ar(Archives::createNamedValue("mytest", mytest));
+        ar.flush().get(); // The backend has written the file
+        {
+            ArchiveRead read{ {},path };
+            test loaded{};
+            loaded.myint = 0;
+            read(Archives::createNamedValue("mytest", loaded));
+            if (loaded.myint != 42 || loaded.mystring != mytest.mystring || loaded.myvecnested.size() != mytest.myvecnested.size())
+                return 1;
+        }
+        // An exception of the backend reaches the next future and the next call
+        ar(Archives::createNamedValue("failing", failing{}));
+        try {
+            ar.flush().get();
+            return 1;
+        }
+        catch (const std::runtime_error&) {
+        }
+        try {
+            ar(Archives::createNamedValue("after", 1));
+            return 1;
+        }
+        catch (const std::runtime_error&) {
+        }
+        // Later flushes deliver the exception through their future
+        auto later = ar.flush();
+        try {
+            later.get();
+            return 1;
+        }
+        catch (const std::runtime_error&) {
+        }
+    }
+    try {
+        Archives::Async_OutputArchive<Archive> ar{ { .max_queued_calls = 0 }, Archive::Options{}, path };
+        return 1;
+    }
+    catch (const std::runtime_error&) { // Would block forever on the first call
+    }
+    path = "test16.json";
+    {
+        test mytest;
+        {
+            Archive backend{ {},path };
+            Archives::Incremental_OutputArchive<Archive> ar{ backend };
+            ar(Archives::createNamedValue("mytest", mytest));
+            if (ar.writtenFields() != 6 || ar.skippedFields() != 0)
+                return 1;
+            mytest.myint = 7; // Only this field is written again
+            ar(Archives::createNamedValue("mytest", mytest));
+            if (ar.writtenFields() != 7 || ar.skippedFields() != 5)
+                return 1;
+        }
+        ArchiveRead ar{ {},path };
+        for (const auto key : { "myint", "myarray", "mystring", "mynested", "myvecnested" }) {
+            if (!ar.json["mytest"].contains(key))
+                return 1;
+        }
+        test loaded{};
+        loaded.myint = 0;
+        loaded.mystring.clear();
+        loaded.mynested.mydouble = 0;
+        loaded.myvecnested.clear();
+        ar(Archives::createNamedValue("mytest", loaded));
+        if (loaded.myint != 7 || loaded.mystring != mytest.mystring || loaded.mynested.mydouble != mytest.mynested.mydouble || loaded.myvecnested.size() != mytest.myvecnested.size())
+            return 1;
+
+        // Padding bytes of long double do not take part in the hash
+        const auto hash = [](unsigned char padding) {
+            alignas(long double) unsigned char storage[sizeof(long double)];
+            std::memset(storage, padding, sizeof(storage));
+            const auto value = ::new (static_cast<void*>(storage)) long double{ 1.25L };
+            std::array<std::complex<long double>, 2> values{};
+            std::memset(static_cast<void*>(values.data()), padding, sizeof(values));
+            values[0] = { 1.5L, -2.0L };
+            values[1] = { *value, 0.0L };
+            Archives::ContentHash_OutputArchive hasher{};
+            hasher(Archives::createNamedValue("value", *value));
+            hasher(Archives::createNamedValue("values", values));
+            return hasher.getHash();
+        };
+        if (hash(0x00) != hash(0xFF))
+            return 1;
+    }
+    path = "test17.json";
+    {
+        test mytest;
+        const auto estimate = Archives::estimate_size(Archives::createNamedValue("mytest", mytest));
+        {
+            Archive ar{ {},path };
+            ar(Archives::createNamedValue("mytest", mytest));
+        }
+        // Groups: mytest, mynested, myvecnested; datasets: myint, myarray, mystring and mydouble/myvector of the three othertest
+        if (estimate.groups != 3 || estimate.datasets != 9 || estimate.fields != 12 || estimate.max_depth != 2)
+            return 1;
+        if (estimate.json_bytes < std::filesystem::file_size(path))
+            return 1;
+    }
+    path = "test18.json";
+    {
+        Archive ar{ {},path };
+        ar(Archives::createNamedValue("value", 2.5));
+        ar(Archives::createNamedValue("mytest", test{}));
+    }
+    {
+        ArchiveRead ar{ {},path };
+        Archives::Deferred<double> value;
+        ar(Archives::createNamedValue("value", value));
+        if (value.isLoaded() || value.getLocation() != "/value")
+            return 1;
+        test mytest{};
+        ar(Archives::createNamedValue("mytest", mytest)); // Loading continues elsewhere before the value is accessed
+        if (value.get() != 2.5 || !value.isLoaded())
+            return 1;
+    }
+    {
+        test mytest;
+        mytest.myint = 11;
+        std::vector<othertest> many(3);
+        {
+            Archive ar{ {},"test19.json" };
+            ar(Archives::createNamedValue("mytest", mytest));
+            ar(Archives::createNamedValue("many", many));
+            ar(Archives::createNamedValue("value", 2.5));
+        }
+        {
+            Archive first{ {},"test20.json" };
+            Archive second{ {},"test21.json" };
+            Archives::Tee_OutputArchive<Archive, Archive> ar{ first, second };
+            ar(Archives::createNamedValue("mytest", mytest));
+            ar(Archives::createNamedValue("many", many));
+            ar(Archives::createNamedValue("value", 2.5));
+        }
+        // Both backends get the same document as the plain archive
+        for (const auto tee : { "test20.json", "test21.json" }) {
+            std::ifstream plain{ "test19.json" };
+            std::ifstream teed{ tee };
+            if (!std::equal(std::istreambuf_iterator<char>{ plain }, {}, std::istreambuf_iterator<char>{ teed }, {}))
+                return 1;
+        }
+    }
+    path = "test22.json";
+    {
+        Archive ar{ {},path };
+        ar(Archives::createNamedValue("loadonly", loadonly{ 5 }));
+        ar(Archives::createNamedValue("broken", std::string{ "not an object" }));
+        std::vector<loadonly> loadonlies;
+        loadonlies.reserve(3);
+        for (int i = 1; i <= 3; ++i)
+            loadonlies.emplace_back(i);
+        ar(Archives::createNamedValue("loadonlies", loadonlies));
+        ar(Archives::createNamedValue("counteds", std::vector<counted>(3)));
+    }
+    {
+        ArchiveRead ar{ {},path };
+        alignas(loadonly) std::byte storage[sizeof(loadonly)];
+        const auto constructed = Archives::LoadConstructor<loadonly>::construct_at(reinterpret_cast<loadonly*>(storage), ar, "loadonly");
+        const bool loaded = constructed->value == 5;
+        std::destroy_at(constructed);
+        if (!loaded || Archives::LoadConstructor<loadonly>::constructWithName(ar, "loadonly").value != 5)
+            return 1;
+
+        alignas(counted) std::byte countedStorage[sizeof(counted)];
+        try {
+            Archives::LoadConstructor<counted>::construct_at(reinterpret_cast<counted*>(countedStorage), ar, "broken");
+            return 1;
+        }
+        catch (const std::exception&) {
+        }
+        if (counted::alive != 0) // Destroyed again after loading failed
+            return 1;
+
+        // Elements are constructed in place in the container
+        std::vector<loadonly> loadonlies;
+        ar(Archives::createNamedValue("loadonlies", loadonlies));
+        if (loadonlies.size() != 3 || loadonlies[0].value != 1 || loadonlies[1].value != 2 || loadonlies[2].value != 3)
+            return 1;
+        counted::constructions = 0;
+        {
+            std::vector<counted> counteds;
+            ar(Archives::createNamedValue("counteds", counteds));
+            if (counteds.size() != 3 || counted::constructions != 3)
+                return 1;
+        }
+        if (counted::alive != 0)
+            return 1;
+    }
+    path = "test23.json";
+    {
+        const auto& table = SerAr::detail::EnumNameTable<shape>::get(shape_variant::enum_values);
+        if (table.find("circle") == nullptr || *table.find("circle") != shape::circle || table.find("square") == nullptr
+            || *table.find("square") != shape::square || table.find("triangle") != nullptr || table.find("") != nullptr)
+            return 1;
+        {
+            Archive ar{ {},path };
+            shape_variant byname{ shape::square, square{ 2.5 } };
+            shape_variant byinteger{ shape::square, square{ 3.5 } };
+            ar(SerAr::createNamedEnumVariant("byname", "byname_params", byname));
+            ar(SerAr::createNamedEnumVariant("byinteger", "byinteger_params", byinteger, SerAr::EnumEncoding::Integer));
+            ar(Archives::createNamedValue("unknown", std::string{ "triangle" }));
+        }
+        ArchiveRead ar{ {},path };
+        if (ar.json["byname"] != "square" || ar.json["byinteger"] != 1)
+            return 1;
+        shape_variant byname{};
+        shape_variant byinteger{};
+        ar(SerAr::createNamedEnumVariant("byname", "byname_params", byname));
+        ar(SerAr::createNamedEnumVariant("byinteger", "byinteger_params", byinteger, SerAr::EnumEncoding::Integer));
+        if (byname.value != shape::square || std::get<square>(byname.variant).side != 2.5
+            || byinteger.value != shape::square || std::get<square>(byinteger.variant).side != 3.5)
+            return 1;
+        try {
+            shape_variant unknown{};
+            ar(SerAr::createNamedEnumVariant("unknown", "unknown_params", unknown));
+            return 1;
+        }
+        catch (const std::out_of_range&) { // Not in the table; from_string rejects it
+        }
+        shape_variant again{}; // The name buffer is reused between loads
+        ar(SerAr::createNamedEnumVariant("byname", "byname_params", again));
+        if (again.value != shape::square || std::get<square>(again.variant).side != 2.5)
+            return 1;
+    }
     //static_assert(Archives::traits::has_type_save_v<othertest, Archives::JSON_OutputArchive>);
     //static_assert(SerAr::IsTypeSaveable<othertest, Archives::JSON_OutputArchive>);
     //static_assert(!SerAr::UseArchiveMemberSave<othertest, Archive>);
@@ -13,6 +13,8 @@
 ///---------------------------------------------------------------------------------------------------
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>
 
@@ -22,6 +24,8 @@
 #include <map>
 #include <iosfwd>
 #include <string>
+#include <string_view>
+#include <memory_resource>
 #include <regex>
 #include <complex>
 #include <exception>
@@ -36,8 +40,11 @@
 #include <MyCEL/basics/BasicIncludes.h>
 
 //#include "ArchiveHelper.h"
+#include <SerAr/Core/ArchiveMemoryResource.h>
+#include <SerAr/Core/ArrayView.h>
 #include <SerAr/Core/NamedValue.h>
 #include <SerAr/Core/NamedValueWithDesc.h>
+#include <SerAr/Core/Deferred.h>
 #include <SerAr/Core/InputArchive.h>
 #include <SerAr/Core/OutputArchive.h>
 
@@ -231,6 +238,33 @@ namespace Archives
             }() };
             return mode;
         }
+
+        //Calls func with the column-major (MATLAB) offset of every element of an array with the given extents in row-major order
+        template<std::size_t Rank, typename Func>
+        static inline void forEachColumnMajorOffset(const std::array<std::size_t, Rank>& extents, Func&& func)
+        {
+            std::array<std::size_t, Rank> strides{};
+            std::size_t count{ 1 };
+            for (std::size_t dim = 0; dim < Rank; ++dim)
+            {
+                strides[dim] = count;
+                count *= extents[dim];
+            }
+            std::array<std::size_t, Rank> index{};
+            std::size_t offset{ 0 };
+            for (std::size_t element = 0; element < count; ++element)
+            {
+                func(offset);
+                for (std::size_t dim = Rank; dim-- > 0;) //The last dimension runs fastest in row-major order
+                {
+                    offset += strides[dim];
+                    if (++index[dim] < extents[dim])
+                        break;
+                    offset -= strides[dim] * extents[dim];
+                    index[dim] = 0;
+                }
+            }
+        }
     };
 
 
@@ -251,14 +285,15 @@ namespace Archives
     public:
         using Options = MatlabOptions;
 
-        MatlabOutputArchive(const std::filesystem::path &fpath, const MatlabOptions &options = MatlabOptions::update);
+        //resource is used for the field stack and names; nullptr = arena owned by the archive
+        MatlabOutputArchive(const std::filesystem::path &fpath, const MatlabOptions &options = MatlabOptions::update, std::pmr::memory_resource* resource = nullptr);
         ~MatlabOutputArchive();
         DISALLOW_COPY_AND_ASSIGN(MatlabOutputArchive)
         template<typename T>
         inline void save(const Archives::NamedValue<T>& value)
         {
-            setNextFieldname(value.name);  //Set the Name of the next Field
-            this->operator()(value.val); //Write Data to the Field/struct
+            setNextFieldname(value.getName());  //Set the Name of the next Field
+            this->operator()(value.getValue()); //Write Data to the Field/struct
             clearNextFieldname();				//Remove the last Fieldname
         }
         template<typename T>
@@ -269,6 +304,16 @@ namespace Archives
             clearNextFieldname();				//Remove the last Fieldname
         }
         
+        //Views (std::span/std::mdspan) are copied once into the mxArray
+        template<typename T> requires (SerAr::IsArrayView<std::remove_cvref_t<T>>)
+        inline void save(const Archives::NamedValue<T>& value)
+        {
+            setNextFieldname(value.getName());
+            auto& arrdata = createMATLABArray(arrayViewData(value.getValue()), arrayViewExtents(value.getValue()));
+            Fields.push(std::make_tuple(std::move(nextFieldname), &arrdata));
+            finishMATLABArray();
+            clearNextFieldname();
+        }
         template<typename T>
         inline std::enable_if_t<MATLAB_traits::has_create_MATLAB_v<MatlabOutputArchive,  std::decay_t<T>>> save(const T& value)
         {	//SFINE checks wether T can be saved by this MATLAB Archive!
@@ -286,6 +331,18 @@ namespace Archives
             finishMATLABArray();
         }
 
+        // Group interface (see SerAr::HasGroupInterface); same as the prologue/epilogue of a nested NamedValue
+        inline void beginGroup(std::string_view name)
+        {
+            struct Group {};
+            setNextFieldname(name);
+            startMATLABArray(Group{});
+            clearNextFieldname();
+        }
+        inline void endGroup()
+        {
+            finishMATLABArray();
+        }
 
     //private:
     private:
@@ -293,10 +350,11 @@ namespace Archives
         MatlabOptions m_options;
         MATFile &m_MatlabFile;
         
-        using Field = std::tuple<std::string, mxArray*>;	
-        std::stack<Field> Fields;	//Using a stack to hold all Fields; Since the implementation is recursive in save().
+        ArchiveMemoryResource mMemory;
+        using Field = std::tuple<std::pmr::string, mxArray*>;	
+        pmr_stack<Field> Fields{ mMemory.get() };	//Using a stack to hold all Fields; Since the implementation is recursive in save().
     
-        std::string nextFieldname;	//Storage for next fieldname which has not been pushed on the Fields stack yet since the mxArray* was not yet created 
+        std::pmr::string nextFieldname{ mMemory.get() };	//Storage for next fieldname which has not been pushed on the Fields stack yet since the mxArray* was not yet created 
 
         MATFile& getMatlabFile(const std::filesystem::path &fpath, const MatlabOptions &options = MatlabOptions::update) const
         {	
@@ -340,9 +398,9 @@ namespace Archives
         }
 
 
-        inline void setNextFieldname(const std::string &str) noexcept
+        inline void setNextFieldname(std::string_view str)
         {
-            nextFieldname = str;
+            nextFieldname.assign(str);
         }
 
         inline void clearNextFieldname() noexcept
@@ -439,6 +497,29 @@ namespace Archives
             return *valarray;
         }
 
+        //Save for views (row-major) with arithmetic payload type; a std::span becomes a column vector
+        template<typename T, std::size_t Rank>
+        mxArray& createMATLABArray(std::span<T> data, const std::array<std::size_t, Rank>& extents) const
+        {
+            using DataType = std::remove_cv_t<T>;
+
+            std::array<mwSize, std::max<std::size_t>(Rank, 2)> dims; //Dimensions in Matlab will always have a minimum of two dimensions!
+            dims.fill(1);
+            std::copy(extents.begin(), extents.end(), dims.begin());
+
+            mxArray *valarray = mxCreateNumericArray(dims.size(), dims.data(), MATLAB::MATLABClassFinder<DataType>::value, mxREAL);
+            if (valarray == nullptr)
+                throw std::runtime_error{ "Unable create new mxArray! (Out of memory?)" };
+
+            DataType * dataposition = static_cast<DataType*>(mxGetData(valarray));
+            assert(dataposition != nullptr || data.empty());
+
+            std::size_t index{ 0 };
+            MatlabHelper::forEachColumnMajorOffset(extents, [&](std::size_t offset) { dataposition[offset] = data[index++]; });
+
+            return *valarray;
+        }
+
 #ifdef EIGEN_CORE_H
         //Eigen Types 
         template<typename T>
@@ -579,8 +660,9 @@ namespace Archives
     public:
         using Options = MatlabOptions;
 
-        MatlabInputArchive(const std::filesystem::path &fpath, const MatlabOptions &options = MatlabOptions::read)
-            : InputArchive(this), m_MatlabFile(getMatlabFile(fpath, options))  {};
+        //resource is used for the field stack and names; nullptr = arena owned by the archive
+        MatlabInputArchive(const std::filesystem::path &fpath, const MatlabOptions &options = MatlabOptions::read, std::pmr::memory_resource* resource = nullptr)
+            : InputArchive(this), m_MatlabFile(getMatlabFile(fpath, options)), mMemory(resource)  {};
         ~MatlabInputArchive() 
         {
             //Cleanup
@@ -599,8 +681,8 @@ namespace Archives
         inline void load(Archives::NamedValue<T>& value)
         {
             checkCurrentField();				//Need to check if the current field is a struct or not; If not we cannot nest further!
-            loadNextField(value.name);			//Loads the next Field with given name; (Move Down)
-            this->operator()(value.val);		//Load Data from the Field or struct.
+            loadNextField(value.getName());		//Loads the next Field with given name; (Move Down)
+            this->operator()(value.getValue());		//Load Data from the Field or struct.
             releaseField();						//Remove the last Fieldname (Move Up)
         }
         template<typename T>
@@ -611,6 +693,35 @@ namespace Archives
             this->operator()(value.val);		//Load Data from the Field or struct.
             releaseField();						//Remove the last Fieldname (Move Up)
         }
+        //Views (std::span/std::mdspan) are filled directly from the mxArray; the field must fit the extents of the view
+        template<typename T> requires (SerAr::IsArrayView<std::remove_cvref_t<T>>)
+        inline void load(Archives::NamedValue<T>& value)
+        {
+            checkCurrentField();
+            loadNextField(value.getName());
+            getArrayView(value.getName(), arrayViewData(value.getValue()), arrayViewExtents(value.getValue()));
+            releaseField();
+        }
+        //Only records the field path. Top level variables are read from the file on first access of the Deferred.
+        template<typename T>
+        inline void load(Archives::NamedValue<Deferred<T>&>& value)
+        {
+            checkCurrentField();
+            std::string location{ mFieldPath };
+            if (!location.empty())
+                location.push_back('.');
+            location.append(value.getName());
+            value.getValue().setLoader(std::move(location), [this](std::string_view loc, T& target) { loadAt(loc, target); });
+        }
+        //Loads a single nested value given by the names of the NamedValues from the root separated by '.'
+        //(e.g. "mytest.mynested.mydouble"). Only the top level variable of the path is read from the file.
+        template<typename T>
+        inline void load_path(std::string_view path, T& value)
+        {
+            if (path.empty())
+                throw std::runtime_error{ "Empty path given to load_path!" };
+            loadAt(path, value);
+        }
         template<typename T>
         inline std::enable_if_t<MATLAB_traits::has_getvalue_MATLAB_v<MatlabInputArchive, std::decay_t<T>>> load(T& value)
         {			
@@ -666,6 +777,23 @@ namespace Archives
             }
         }
 
+        template<typename T, std::size_t Rank>
+        inline void getArrayView(std::string_view name, std::span<T> data, const std::array<std::size_t, Rank>& extents)
+        {
+            static_assert(!std::is_const_v<T>, "Cannot load into a view of const elements!");
+            const auto fieldptr = std::get<1>(mFields.top());
+
+            if (mxGetClassID(fieldptr) != MATLAB::MATLABClassFinder<T>::value)
+                throw std::runtime_error{ "MATLAB field '" + std::string{ name } + "' has a different class than the elements of the view!" };
+
+            const std::span<const std::size_t> dims{ reinterpret_cast<const std::size_t*>(mxGetDimensions(fieldptr)), mxGetNumberOfDimensions(fieldptr) };
+            checkArrayViewExtents(name, dims, extents);
+
+            const T * dataposition = reinterpret_cast<const T*>(mxGetData(fieldptr));
+            std::size_t index{ 0 };
+            MatlabHelper::forEachColumnMajorOffset(extents, [&](std::size_t offset) { data[index++] = dataposition[offset]; });
+        }
+
 #ifdef EIGEN_CORE_H
 
         template<typename T>
@@ -802,8 +930,10 @@ namespace Archives
     private:
         MATFile &m_MatlabFile;
 
-        using Field = std::tuple<std::string, mxArray * const>;
-        std::stack<Field> mFields;	//Using a stack to hold all Fields; Since the implementation is recursive in save().
+        ArchiveMemoryResource mMemory;
+        using Field = std::tuple<std::pmr::string, mxArray * const>;
+        pmr_stack<Field> mFields{ mMemory.get() };	//Using a stack to hold all Fields; Since the implementation is recursive in save().
+        std::pmr::string mFieldPath{ mMemory.get() };	//Names of all fields on the stack joined by '.' (only used for Deferred)
 
         MATFile& getMatlabFile(const std::filesystem::path &fpath, const MatlabOptions &options) const
         {
@@ -833,14 +963,15 @@ namespace Archives
                 else
                 {
                     const auto& name = std::get<0>(top);
-                    throw std::runtime_error{ std::string{ "Unable to nest current field. Field is not a struct. Fieldname: " } +name };
+                    throw std::runtime_error{ std::string{ "Unable to nest current field. Field is not a struct. Fieldname: " } + std::string{ name } };
                 }
             }
         };
 
-        inline void loadNextField(const std::string &str)
+        inline void loadNextField(std::string_view name)
         {
             mxArray * nextarr = nullptr;
+            std::pmr::string str{ name, mMemory.get() }; // MATLAB needs a null terminated name and the field stores it anyway
 
             if (mFields.empty())
             {
@@ -853,16 +984,18 @@ namespace Archives
                 nextarr = mxGetField(arr, 0, str.c_str());
             }
             if (nextarr == nullptr)
-                throw std::runtime_error{ std::string{ "Could not access field: " } +str };
-            mFields.emplace(str, nextarr);
+                throw std::runtime_error{ std::string{ "Could not access field: " } + std::string{ str } };
+            if (!mFieldPath.empty())
+                mFieldPath.push_back('.');
+            mFieldPath.append(str);
+            mFields.emplace(std::move(str), nextarr);
         };
 
         inline void releaseField() noexcept
         {
             assert(!mFields.empty());
 
-            const auto top = mFields.top();
-            const auto arr = std::get<1>(top);
+            const auto arr = std::get<1>(mFields.top());
 
             //Seems like we only need to destroy the last array within the stack. 
             //Trying to delete all other arrays or only the structs gave an access violation exception from MATLAB! 
@@ -870,8 +1003,41 @@ namespace Archives
                 mxDestroyArray(arr);
 
             mFields.pop();
+            const auto pos = mFieldPath.rfind('.');
+            mFieldPath.resize(pos == std::string::npos ? 0 : pos);
         };
 
+        //Loads value from a field path ('.' separated). The current fields are restored afterwards.
+        template<typename T>
+        void loadAt(std::string_view location, T& value)
+        {
+            struct RestoreFields {
+                MatlabInputArchive& ar;
+                pmr_stack<Field> fields;
+                std::pmr::string path;
+                explicit RestoreFields(MatlabInputArchive& archive)
+                    : ar(archive), fields(archive.mMemory.get()), path(archive.mMemory.get()) {
+                    std::swap(fields, ar.mFields);
+                    std::swap(path, ar.mFieldPath);
+                }
+                ~RestoreFields() {
+                    while (!ar.mFields.empty())
+                        ar.releaseField();
+                    std::swap(fields, ar.mFields);
+                    std::swap(path, ar.mFieldPath);
+                }
+            } restore{ *this };
+
+            for (auto pos = location.find('.'); ; pos = location.find('.')) {
+                checkCurrentField();
+                loadNextField(location.substr(0, pos));
+                if (pos == location.npos)
+                    break;
+                location.remove_prefix(pos + 1);
+            }
+            this->operator()(value);
+        }
+
         template<typename Container>
         std::enable_if_t<stdext::is_container_v<std::decay_t<Container>>> resizeContainer(Container& cont,const std::size_t& size)
         {
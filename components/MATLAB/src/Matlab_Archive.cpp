@@ -16,8 +16,8 @@ namespace Archives
     /// <param name="fpath">  	The filepath to the MATLAB file. </param>
     /// <param name="options">	(Optional) options for controlling the operation. </param>
     ///-------------------------------------------------------------------------------------------------
-    MatlabOutputArchive::MatlabOutputArchive(const std::filesystem::path &fpath, const MatlabOptions &options)
-        : OutputArchive(this), m_filepath(fpath), m_options(options), m_MatlabFile(getMatlabFile(fpath, options)) {};
+    MatlabOutputArchive::MatlabOutputArchive(const std::filesystem::path &fpath, const MatlabOptions &options, std::pmr::memory_resource* resource)
+        : OutputArchive(this), m_filepath(fpath), m_options(options), m_MatlabFile(getMatlabFile(fpath, options)), mMemory(resource) {};
 
     ///-------------------------------------------------------------------------------------------------
     /// <summary>	Destructor. </summary>
@@ -42,7 +42,7 @@ namespace Archives
 
         //assert(!Fields.empty());// , "Trying to pop more mxArrays from the stack than had been pushed"); //Programming error!
 
-        auto TopField = Fields.top(); //Thats the field we have to add! (Child mxArray)
+        auto TopField = std::move(Fields.top()); //Thats the field we have to add! (Child mxArray)
         Fields.pop(); //Remove it
 
         if (Fields.empty()) //at the bottom lvl; write array to mat
@@ -2,6 +2,7 @@
 
 #include <stack>
 #include <type_traits>
+#include <string_view>
 
 #include <cstdio> // std::puts
 
@@ -31,6 +32,11 @@ namespace SerAr
 
         template<SizeableContainer T>
         static constexpr bool is_sizeable_container_v<T> = true;
+
+        inline QString toQString(std::string_view str)
+        {
+            return QString::fromUtf8(str.data(), static_cast<int>(str.size()));
+        }
     }
     using namespace Archives;
 
@@ -44,7 +50,7 @@ namespace SerAr
     public:
         NamedValue<T> named_value;
 
-        QtUI_ContainerItem(NamedValue<T> nv) : QStandardItem(QString::fromStdString(nv.name)), named_value(nv)
+        QtUI_ContainerItem(NamedValue<T> nv) : QStandardItem(details::toQString(nv.getName())), named_value(nv)
         {
         }
 
@@ -61,7 +67,7 @@ namespace SerAr
     public:
         NamedValue<T> named_value;
 
-        QtUI_SizeableContainerItem(NamedValue<T> nv) : QStandardItem(QString::fromStdString(nv.name)), named_value(nv)
+        QtUI_SizeableContainerItem(NamedValue<T> nv) : QStandardItem(details::toQString(nv.getName())), named_value(nv)
         {
         }
 
@@ -126,7 +132,7 @@ namespace SerAr
     public:
         NamedValue<T> named_value;
 
-        QtUI_StructItem(NamedValue<T> nv) : QStandardItem(QString::fromStdString(nv.name)), named_value(nv)
+        QtUI_StructItem(NamedValue<T> nv) : QStandardItem(details::toQString(nv.getName())), named_value(nv)
         {
         }
 
@@ -260,7 +266,7 @@ namespace SerAr
             newval->setEditable(false);
             appendItemToStack(newval);
             itemstack.push(newval);
-            this->operator()(nv.val);
+            this->operator()(nv.getValue());
             itemstack.pop();
             resizeNameColumn();
             return *this;
@@ -269,7 +275,7 @@ namespace SerAr
         template<typename T> 
         requires (stdext::is_string_v<std::remove_cvref_t<T>>)
         ThisClass& load(NamedValue<T>& nv) {
-            auto name = std::make_unique<QStandardItem>(QString::fromStdString(nv.name));
+            auto name = std::make_unique<QStandardItem>(details::toQString(nv.getName()));
             name->setEditable(false);
             auto value = std::make_unique<QtUI_ValueItem<T>>(nv);
             QList<QStandardItem *> items;
@@ -282,7 +288,7 @@ namespace SerAr
         template<typename T> 
         requires (std::is_arithmetic_v<std::remove_cvref_t<T>> || std::is_same_v<bool,std::remove_cvref_t<T>>)
         ThisClass& load(NamedValue<T>& nv) {
-            auto name = std::make_unique<QStandardItem>(QString::fromStdString(nv.name));
+            auto name = std::make_unique<QStandardItem>(details::toQString(nv.getName()));
             name->setEditable(false);
             auto value = std::make_unique<QtUI_ValueItem<T>>(nv);
             QList<QStandardItem *> items;
@@ -306,7 +312,7 @@ namespace SerAr
             appendItemToStack(items);
             itemstack.push(items[0]);
             std::size_t counter = 0;
-            for(auto& elem : nv.val) {
+            for(auto& elem : nv.getValue()) {
                 this->operator()(NamedValue(fmt::format("[{}]",counter++),elem));
             }
             itemstack.pop();
@@ -322,12 +328,12 @@ namespace SerAr
             name->setEditable(false);
             QList<QStandardItem *> items;
             items.push_back(name.release());
-            auto value = std::make_unique<QStandardItem>(QString::fromStdString(fmt::format("[size: {}]",nv.val.size())));
+            auto value = std::make_unique<QStandardItem>(QString::fromStdString(fmt::format("[size: {}]",nv.getValue().size())));
             items.push_back(value.release());
             appendItemToStack(items);
             itemstack.push(items[0]);
             std::size_t counter = 0;
-            for(auto& elem : nv.val) {
+            for(auto& elem : nv.getValue()) {
                 this->operator()(NamedValue(fmt::format("[{}]",counter++),elem));
             }
             itemstack.pop();
@@ -343,14 +349,14 @@ namespace SerAr
             name->setEditable(false);
             QList<QStandardItem *> items;
             items.push_back(name.release());
-            auto value = std::make_unique<QStandardItem>(QString::fromStdString(fmt::format("[size: {} x {}]",nv.val.rows(),nv.val.cols())));
+            auto value = std::make_unique<QStandardItem>(QString::fromStdString(fmt::format("[size: {} x {}]",nv.getValue().rows(),nv.getValue().cols())));
             value->setEditable(false);
             items.push_back(value.release());
             appendItemToStack(items);
             itemstack.push(items[0]);
-            for(std::size_t row = 0; row < nv.val.rows(); row++) {
-                for(std::size_t col = 0; col < nv.val.cols(); col++) {
-                this->operator()(NamedValue(fmt::format("[{},{}]",row,col),nv.val(row,col)));
+            for(std::size_t row = 0; row < nv.getValue().rows(); row++) {
+                for(std::size_t col = 0; col < nv.getValue().cols(); col++) {
+                this->operator()(NamedValue(fmt::format("[{},{}]",row,col),nv.getValue()(row,col)));
             } }
             itemstack.pop();
             return *this;
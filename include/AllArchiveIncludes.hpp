@@ -13,8 +13,16 @@
 ///---------------------------------------------------------------------------------------------------
 
 #include "AllArchiveEnums.hpp"
+#include <algorithm>
+#include <cctype>
+#include <concepts>
 #include <filesystem>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
 #include <MyCEL/basics/templatehelpers.h>
 
 #ifdef SERAR_HAS_CONFIGFILE
@@ -122,8 +130,9 @@ namespace SerAr {
     struct output_archive_traits<ArchiveTypeEnum::HDF5> {
         using archive_type = Archives::HDF5_OutputArchive;
         using option_type = Archives::HDF5_OutputOptions;
-        static constexpr auto append_option = option_type{.FileCreationMode=Archives::HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode::OpenOrCreate};
-        static constexpr auto overwrite_option = option_type{.FileCreationMode=Archives::HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode::CreateOrOverwrite};
+        // HDF5_OutputOptions is no aggregate (private options base) and not constexpr constructible
+        static inline const option_type append_option = [] { option_type opt{}; opt.FileCreationMode = ::HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode::OpenOrCreate; return opt; }();
+        static inline const option_type overwrite_option = [] { option_type opt{}; opt.FileCreationMode = ::HDF5_Wrapper::HDF5_GeneralOptions::HDF5_Mode::CreateOrOverwrite; return opt; }();
     };
 
     template<>
@@ -132,7 +141,7 @@ namespace SerAr {
         using output = output_archive_traits<enum_value>;
         using input= input_archive_traits<enum_value>;
         static constexpr std::string_view defaut_file_extension {"hdf5"};
-        static constexpr std::array<std::string_view,2> possible_file_extensions { {"hdf5"},{"h5"}};
+        static constexpr std::array<std::string_view,2> possible_file_extensions { {{"hdf5"}, {"h5"}} };
     };
     template<>
     struct archive_enum_value_from_type<Archives::HDF5_InputArchive> {
@@ -232,96 +241,200 @@ namespace SerAr {
     template<const auto &Input>
     static constexpr const auto available_input_archives_from_array = get_input_available_if<Input,is_input_archive_available>();
 
-    //static constexpr const auto all_available_output_archives = available_output_archives_from_array<AllArchiveTypeEnums>;
-    //static constexpr const auto all_available_input_archives = available_input_archives_from_array<AllArchiveTypeEnums>;
-
-    //template<ArchiveTypeEnum value>
-    //struct output_archives_enum_mapping { using type = typename output_archive_traits<value>::archive_type; };
-    //template <ArchiveTypeEnum... Values>
-    //using output_archives_variant_helper_t = typename MyCEL::enum_variant_creator_t<ArchiveTypeEnum, output_archives_enum_mapping, Values...>;
-    //template<const auto &Input>
-    //using output_archives_variant = typename MyCEL::apply_nttp_t<Input,output_archives_variant_helper_t>;
-    //using all_output_archives_variant = typename MyCEL::apply_nttp_t<all_available_output_archives,output_archives_variant_helper_t>;
-
-    //template<ArchiveTypeEnum value>
-    //struct input_archives_enum_mapping { using type = typename input_archive_traits<value>::archive_type; };
-    //template <ArchiveTypeEnum... Values>
-    //using input_archives_variant_helper_t = typename MyCEL::enum_variant_creator_t<ArchiveTypeEnum, input_archives_enum_mapping, Values...>;
-    //template<const auto &Input>
-    //using input_archives_variant = typename MyCEL::apply_nttp_t<Input,input_archives_variant_helper_t>;
-    //using all_input_archives_variant = typename MyCEL::apply_nttp_t<all_available_input_archives,input_archives_variant_helper_t>;
-
-
-    //    static constexpr const ArchiveTypeEnum value = ArchiveTypeEnum::JSON;
-
-    // template<typename input_variant, ArchiveTypeEnum value>
-    // struct input_archive_switch_case
-    // {
-    //     template<typename Archive>
-    //     void operator()(input_variant& ar, )
-    //     {
-    //         using anisotropy_param_type = typename anisotropy_enum_property_mapping<value>::type;
-    //         if(!std::holds_alternative<anisotropy_param_type>(aniso) )
-    //         {
-    //             aniso = anisotropy_param_type{};
-    //         }
-    //     }
-    // };
-    // template<const auto &Input, template <std::remove_cvref_t<decltype(::std::get<0>(Input))>> typename available_if, std::size_t... Is>
-    // constexpr auto create_bool_array_available_if_impl(std::index_sequence<Is...>) {
-    //     using array_type = std::remove_cvref_t<decltype(::std::get<0>(Input))>;
-    //     return MyCEL::static_map<array_type, bool,sizeof...(Is)> { 
-    //         { std::pair<array_type,bool>{const_cast<array_type&>(::std::get<Is>(Input)), available_if<::std::get<Is>(Input)>()} ... } 
-    //         };
-    // }
-    //template<const auto &Input, template <std::remove_cvref_t<decltype(::std::get<0>(Input))>> typename traits, std::size_t... Is>
-    //constexpr auto get_archive_by_extension_impl(std::index_sequence<Is...>) {
-    //    using array_type = std::remove_cvref_t<decltype(::std::get<0>(Input))>;
-    //    return MyCEL::static_map<array_type, bool,sizeof...(Is)> { 
-    //        { std::pair<array_type,bool>{const_cast<array_type&>(::std::get<Is>(Input)), available_if<::std::get<Is>(Input)>()} ... } 
-    //        };
-    //}
-
-    // TODO
-    // template<const auto &Input, template <std::remove_cvref_t<decltype(::std::get<0>(Input))>> typename traits> 
-    // constexpr std::optional<> get_archive_by_extension(const std::filesystem::path& path)
-    // {
-    //     auto 
-        
-    // }
-    // template<const auto &Input> 
-    // constexpr auto open_input_archive(const std::filesystem::path& path)
-    // {
-    //     using input_variant = input_archives_variant<Input>;
+    static constexpr const auto all_available_output_archives = available_output_archives_from_array<AllArchiveTypeEnums>;
+    static constexpr const auto all_available_input_archives = available_input_archives_from_array<AllArchiveTypeEnums>;
 
+    template<const auto &Input, template <ArchiveTypeEnum> typename traits, typename Indices = std::make_index_sequence<Input.size()>>
+    struct archives_variant_helper;
+    template<const auto &Input, template <ArchiveTypeEnum> typename traits, std::size_t... Is>
+    struct archives_variant_helper<Input, traits, std::index_sequence<Is...>> {
+        using type = std::variant<typename traits<::std::get<Is>(Input)>::archive_type...>;
+    };
+    template<const auto &Input>
+    using output_archives_variant = typename archives_variant_helper<Input, output_archive_traits>::type;
+    template<const auto &Input>
+    using input_archives_variant = typename archives_variant_helper<Input, input_archive_traits>::type;
+
+    namespace detail {
+        inline bool extension_equal(std::string_view lhs, std::string_view rhs) noexcept
+        {
+            return std::ranges::equal(lhs, rhs, [](unsigned char l, unsigned char r) { return std::tolower(l) == std::tolower(r); });
+        }
+
+        template<const auto &Input, std::size_t... Is>
+        std::optional<std::size_t> archive_index_by_extension_impl(std::string_view extension, std::index_sequence<Is...>) noexcept
+        {
+            std::optional<std::size_t> result;
+            const auto matches = [extension](const auto& possible) {
+                return std::ranges::any_of(possible, [extension](std::string_view elem) { return extension_equal(extension, elem); });
+            };
+            ((matches(archive_traits<::std::get<Is>(Input)>::possible_file_extensions) ? (result = Is, true) : false) || ...);
+            return result;
+        }
+
+        // Index of the first archive in Input which uses the extension of path
+        template<const auto &Input>
+        std::optional<std::size_t> archive_index_by_extension(const std::filesystem::path& path)
+        {
+            const auto extension = path.extension().string();
+            std::string_view view{ extension };
+            if (!view.empty() && view.front() == '.')
+                view.remove_prefix(1);
+            return archive_index_by_extension_impl<Input>(view, std::make_index_sequence<Input.size()>());
+        }
+
+        template<const auto &Input>
+        std::size_t archive_index_by_extension_or_throw(const std::filesystem::path& path)
+        {
+            const auto index = archive_index_by_extension<Input>(path);
+            if (!index)
+                throw std::runtime_error{ "No available archive for file extension '" + path.extension().string() + "' of file: " + path.string() };
+            return *index;
+        }
+
+        // The variants are build in place (archives are not necessarily movable)
+        template<const auto &Input, typename Variant, std::size_t I = 0>
+        Variant make_output_archive_variant(std::size_t index, const std::filesystem::path& path, ArchiveOutputMode mode)
+        {
+            if constexpr (I + 1 < Input.size()) {
+                if (index != I)
+                    return make_output_archive_variant<Input, Variant, I + 1>(index, path, mode);
+            }
+            using traits = output_archive_traits<::std::get<I>(Input)>;
+            using archive_type = typename traits::archive_type;
+            using option_type = typename traits::option_type;
+            const option_type& options = (mode == ArchiveOutputMode::Append) ? traits::append_option : traits::overwrite_option;
+            if constexpr (std::constructible_from<archive_type, const std::filesystem::path&, const option_type&>)
+                return Variant{ std::in_place_index<I>, path, options };
+            else if constexpr (std::constructible_from<archive_type, const option_type&, const std::filesystem::path&>)
+                return Variant{ std::in_place_index<I>, options, path };
+            else
+                return Variant{ std::in_place_index<I>, path };
+        }
+
+        template<const auto &Input, typename Variant, std::size_t I = 0>
+        Variant make_input_archive_variant(std::size_t index, const std::filesystem::path& path)
+        {
+            if constexpr (I + 1 < Input.size()) {
+                if (index != I)
+                    return make_input_archive_variant<Input, Variant, I + 1>(index, path);
+            }
+            using traits = input_archive_traits<::std::get<I>(Input)>;
+            using archive_type = typename traits::archive_type;
+            using option_type = typename traits::option_type;
+            if constexpr (std::constructible_from<archive_type, const std::filesystem::path&, const option_type&>)
+                return Variant{ std::in_place_index<I>, path, option_type{} };
+            else if constexpr (std::constructible_from<archive_type, const option_type&, const std::filesystem::path&>)
+                return Variant{ std::in_place_index<I>, option_type{}, path };
+            else
+                return Variant{ std::in_place_index<I>, path };
+        }
+    }
 
-    // };
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Gets the archive used for the extension of path </summary>
+    ///
+    /// <returns>	The archive type or std::nullopt if no archive in Input uses the extension. </returns>
+    ///-------------------------------------------------------------------------------------------------
+    template<const auto &Input = all_available_output_archives>
+    std::optional<ArchiveTypeEnum> get_archive_by_extension(const std::filesystem::path& path)
+    {
+        const auto index = detail::archive_index_by_extension<Input>(path);
+        if (!index)
+            return std::nullopt;
+        return Input[*index];
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Output archive selected at runtime. 
+    /// 			Every call to operator() does a single std::visit and then runs the statically typed
+    /// 			archive, so all nested fields are dispatched at compile time as usual. Types
+    /// 			serialized through it therefore need templated save/serialize functions. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    template<const auto &Input = all_available_output_archives>
+    class Variant_OutputArchive
+    {
+        static_assert(Input.size() > 0, "No output archive available!");
+    public:
+        using variant_type = output_archives_variant<Input>;
+
+        Variant_OutputArchive(const std::filesystem::path& path, ArchiveOutputMode mode = ArchiveOutputMode::Overwrite)
+            : archive(detail::make_output_archive_variant<Input, variant_type>(detail::archive_index_by_extension_or_throw<Input>(path), path, mode)) {}
+
+        template <typename ... Types>
+        inline Variant_OutputArchive& operator()(Types&& ... args)
+        {
+            std::visit([&](auto& ar) { ar(std::forward<Types>(args)...); }, archive);
+            return *this;
+        }
+
+        ArchiveTypeEnum getArchiveType() const noexcept { return Input[archive.index()]; }
+        variant_type& getArchive() noexcept { return archive; }
+        const variant_type& getArchive() const noexcept { return archive; }
+    private:
+        variant_type archive;
+    };
 
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Input archive selected at runtime. See Variant_OutputArchive. </summary>
+    ///-------------------------------------------------------------------------------------------------
+    template<const auto &Input = all_available_input_archives>
+    class Variant_InputArchive
+    {
+        static_assert(Input.size() > 0, "No input archive available!");
+    public:
+        using variant_type = input_archives_variant<Input>;
+
+        explicit Variant_InputArchive(const std::filesystem::path& path)
+            : archive(detail::make_input_archive_variant<Input, variant_type>(detail::archive_index_by_extension_or_throw<Input>(path), path)) {}
+
+        template <typename ... Types>
+        inline Variant_InputArchive& operator()(Types&& ... args)
+        {
+            std::visit([&](auto& ar) { ar(std::forward<Types>(args)...); }, archive);
+            return *this;
+        }
+
+        // Loads a single nested value given by the '.' separated names of the NamedValues from the root
+        template<typename T>
+        inline void load_path(std::string_view path, T& value)
+        {
+            std::visit([&](auto& ar) {
+                if constexpr (requires { ar.load_path(path, value); })
+                    ar.load_path(path, value);
+                else
+                    throw std::runtime_error{ "Archive does not support load_path!" };
+            }, archive);
+        }
+
+        ArchiveTypeEnum getArchiveType() const noexcept { return Input[archive.index()]; }
+        variant_type& getArchive() noexcept { return archive; }
+        const variant_type& getArchive() const noexcept { return archive; }
+    private:
+        variant_type archive;
+    };
 
-        // template<IAnisotropy value>
-        // struct anisotropy_switch_case
-        // {
-        //     template<typename Archive>
-        //     void operator()(anisotropy_variant& aniso, Archive &ar)
-        //     {
-        //         using anisotropy_param_type = typename anisotropy_enum_property_mapping<value>::type;
-        //         if(!std::holds_alternative<anisotropy_param_type>(aniso) )
-        //         {
-        //             aniso = anisotropy_param_type{};
-        //         }
-        //         ar(Archives::createNamedValue(::Properties::Anisotropy::General<prec>::getSectionName(), std::get<anisotropy_param_type>(aniso)));
-        //     }
-        // };
-
-        // struct anisotropy_default_switch_case
-        // {
-        //     template<typename Archive>
-        //     void operator()(anisotropy_variant& /* aniso */, Archive &/* ar */)
-        //     {
-        //         throw std::out_of_range{"Type of anisotropy unknown!"};
-        //     }
-        // };
-        //MyCEL::enum_switch::run<decltype(TypeOfAnisotropy),anisotropy_default_switch_case,anisotropy_switch_case>(TypeOfAnisotropy,AnisotropyProperties,ar);
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Opens the output archive matching the extension of path. </summary>
+    ///
+    /// <exception cref="std::runtime_error">	Thrown if no archive in Input uses the extension. </exception>
+    ///-------------------------------------------------------------------------------------------------
+    template<const auto &Input = all_available_output_archives>
+    Variant_OutputArchive<Input> open_output_archive(const std::filesystem::path& path, ArchiveOutputMode mode = ArchiveOutputMode::Overwrite)
+    {
+        return Variant_OutputArchive<Input>{ path, mode };
+    }
+
+    ///-------------------------------------------------------------------------------------------------
+    /// <summary>	Opens the input archive matching the extension of path. </summary>
+    ///
+    /// <exception cref="std::runtime_error">	Thrown if no archive in Input uses the extension. </exception>
+    ///-------------------------------------------------------------------------------------------------
+    template<const auto &Input = all_available_input_archives>
+    Variant_InputArchive<Input> open_input_archive(const std::filesystem::path& path)
+    {
+        return Variant_InputArchive<Input>{ path };
+    }
 }
 
 #endif	// INC_AllArchiveIncludes_H
@@ -0,0 +1,150 @@
+// Only built with the CMake option SERAR_WITH_FIELDOBSERVER (defines SERAR_HAS_FIELD_OBSERVER for Core)
+#ifndef SERAR_HAS_FIELD_OBSERVER
+#error "SerAr_FieldObserverTest requires SERAR_HAS_FIELD_OBSERVER"
+#endif
+
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SerAr/Core/FieldObserver.h>
+#include <SerAr/Core/NamedValue.h>
+#include <SerAr/Core/SizeEstimate_OutputArchive.h>
+// The archives declare their own Archives::detail; the observer hooks must still compile inside them
+#ifdef SERAR_HAS_CONFIGFILE
+#include <SerAr/ConfigFile/ConfigFile_Archive.h>
+#endif
+#ifdef SERAR_HAS_HDF5
+#include <SerAr/HDF5/HDF5_Archive.h>
+#endif
+
+#include "SerAr_ExampleStructs.h"
+
+struct Recorded {
+    std::string path;
+    std::string name;
+    std::size_t bytes;
+    std::size_t depth;
+};
+
+class Recorder final : public SerAr::IFieldObserver
+{
+public:
+    std::vector<Recorded> fields{};
+    void onField(const SerAr::FieldEvent& event) override
+    {
+        fields.push_back(Recorded{ std::string{ event.path }, std::string{ event.name }, event.bytes, event.depth });
+    }
+    const Recorded* find(const std::string& path) const
+    {
+        for (const auto& field : fields) {
+            if (field.path == path && !field.name.empty())
+                return &field;
+        }
+        return nullptr;
+    }
+};
+
+// Structure all archives can store
+struct observedinner {
+    double mydouble{ 1.5 };
+};
+struct observed {
+    int myint{ 3 };
+    observedinner mynested{};
+};
+
+template<SerAr::IsArchive Archive>
+void serialize(observedinner& val, Archive& ar)
+{
+    ar(Archives::createNamedValue("mydouble", val.mydouble));
+}
+
+template<SerAr::IsArchive Archive>
+void serialize(observed& val, Archive& ar)
+{
+    ar(Archives::createNamedValue("myint", val.myint));
+    ar(Archives::createNamedValue("mynested", val.mynested));
+}
+
+// Every archive reports the named fields with the same paths and depths
+template<typename Archive>
+static bool observedSave(Archive& ar)
+{
+    observed value{};
+    Recorder recorder;
+    ar.setFieldObserver(&recorder);
+    ar(Archives::createNamedValue("observed", value));
+    const auto myint = recorder.find("observed.myint");
+    const auto mydouble = recorder.find("observed.mynested.mydouble");
+    return myint != nullptr && myint->depth == 1 && mydouble != nullptr && mydouble->depth == 2
+        && !recorder.fields.empty() && recorder.fields.back().name == "observed";
+}
+
+int main()
+{
+    test mytest;
+    Recorder recorder;
+    Archives::SizeEstimate_OutputArchive ar{};
+    ar.setFieldObserver(&recorder);
+    ar(Archives::createNamedValue("mytest", mytest));
+
+    for (const auto& field : recorder.fields)
+        std::cout << field.path << " (" << field.name << "): " << field.bytes << " bytes, depth " << field.depth << '\n';
+
+    // Payload estimates: arithmetic values, strings and ranges of them
+    struct Expected {
+        const char* path;
+        std::size_t bytes;
+        std::size_t depth;
+    };
+    const std::size_t nested = sizeof(double) + 3; // othertest: mydouble and three strings of one character
+    const Expected expected[] = {
+        { "mytest.myint", sizeof(int), 1 },
+        { "mytest.myarray", 3 * sizeof(double), 1 },
+        { "mytest.mystring", mytest.mystring.size(), 1 },
+        { "mytest.mynested.mydouble", sizeof(double), 2 },
+        { "mytest.mynested.myvector", 3, 2 },
+        { "mytest.mynested", nested, 1 },
+        { "mytest.myvecnested.mydouble", sizeof(double), 2 },
+        { "mytest.myvecnested", 2 * nested, 1 },
+        { "mytest", sizeof(int) + 3 * sizeof(double) + mytest.mystring.size() + 3 * nested, 0 },
+    };
+    for (const auto& field : expected) {
+        const auto found = recorder.find(field.path);
+        if (found == nullptr || found->bytes != field.bytes || found->depth != field.depth) {
+            std::cerr << "Unexpected report for " << field.path << '\n';
+            return 1;
+        }
+    }
+    // Nested fields are reported before their parent; unnamed values (the struct itself, container elements) too
+    if (recorder.fields.size() != 17 || recorder.fields.back().name != "mytest")
+        return 1;
+
+    // Without an observer nothing is reported
+    ar.setFieldObserver(nullptr);
+    const auto reported = recorder.fields.size();
+    ar(Archives::createNamedValue("mytest", mytest));
+    if (recorder.fields.size() != reported)
+        return 1;
+
+#ifdef SERAR_HAS_CONFIGFILE
+    {
+        std::ostringstream stream;
+        Archives::ConfigFile_OutputArchive configar{ stream };
+        if (!observedSave(configar))
+            return 1;
+    }
+#endif
+#ifdef SERAR_HAS_HDF5
+    {
+        Archives::HDF5_OutputArchive hdf5ar{ std::filesystem::path{ "fieldobserver.h5" } };
+        if (!observedSave(hdf5ar))
+            return 1;
+    }
+#endif
+    return 0;
+}
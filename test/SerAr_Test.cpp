@@ -2,12 +2,58 @@
 #include <iostream>
 #include <array>
 #include <algorithm>
+#include <filesystem>
 #include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+#include <type_traits>
 
 
 #include <MyCEL/basics/enumhelpers.h>
 enum class testenum {value1, value2, value3};
 
+struct roundtrip {
+    int myint{ 0 };
+    double mydouble{ 0.0 };
+    std::vector<double> myvector{};
+};
+template<SerAr::IsArchive Archive>
+void serialize(roundtrip& val, Archive& ar) {
+    ar(Archives::createNamedValue("myint", val.myint));
+    ar(Archives::createNamedValue("mydouble", val.mydouble));
+    ar(Archives::createNamedValue("myvector", val.myvector));
+}
+
+// Writes through open_output_archive and reads back through open_input_archive
+template<SerAr::ArchiveTypeEnum value>
+bool roundTripByExtension()
+{
+    using namespace SerAr;
+    const auto path = std::filesystem::temp_directory_path() / ("SerAr_Test." + std::string{ archive_traits<value>::defaut_file_extension });
+    roundtrip written{ .myint = 7, .mydouble = 1.25, .myvector = { 1.0, 2.5, -3.0 } };
+    roundtrip loaded{};
+    {
+        auto ar = open_output_archive(path);
+        if (ar.getArchiveType() != value)
+            return false;
+        ar(Archives::createNamedValue("value", written));
+    }
+    {
+        auto ar = open_input_archive(path);
+        if (ar.getArchiveType() != value)
+            return false;
+        ar(Archives::createNamedValue("value", loaded));
+    }
+    std::filesystem::remove(path);
+    return loaded.myint == written.myint && loaded.mydouble == written.mydouble && loaded.myvector == written.myvector;
+}
+template<std::size_t... Is>
+bool roundTripByExtension(std::index_sequence<Is...>)
+{
+    return (roundTripByExtension<SerAr::all_available_input_archives[Is]>() && ...);
+}
+
 int main()
 {
     using namespace Archives;
@@ -17,6 +63,11 @@ int main()
     static_assert(count_available_if<AllArchiveTypeEnums,is_output_archive_available>()==3);
     static_assert(!(count_available_if<AllArchiveTypeEnums,is_output_archive_available>()==4));
 
+    // NamedValue::getValue() must never copy the stored value (allocations are measured by SerAr_Bench)
+    static_assert(std::is_same_v<decltype(std::declval<const NamedValue<std::vector<double>>&>().getValue()), const std::vector<double>&>);
+    static_assert(std::is_same_v<decltype(std::declval<NamedValue<std::vector<double>>&>().getValue()), std::vector<double>&>);
+    static_assert(std::is_same_v<decltype(std::declval<const NamedValue<std::vector<double>&>&>().getValue()), std::vector<double>&>);
+
     for( std::size_t i = 0; i < AllArchiveTypeEnums.size(); ++i)
     {
         std::cout << ArchiveTypeEnumMap[AllArchiveTypeEnums[i]] << std::endl;
@@ -32,5 +83,23 @@ int main()
     {
         std::cout << ArchiveTypeEnumMap[elem] << std::endl;
     }
+
+    if (get_archive_by_extension("test.xyz").has_value())
+    {
+        std::cerr << "Unknown file extension selected an archive!" << std::endl;
+        return 1;
+    }
+    if (!roundTripByExtension(std::make_index_sequence<all_available_input_archives.size()>{}))
+    {
+        std::cerr << "Round trip through open_output_archive/open_input_archive failed!" << std::endl;
+        return 1;
+    }
+#ifdef SERAR_HAS_JSON
+    if (get_archive_by_extension("test.JSON") != ArchiveTypeEnum::JSON)
+    {
+        std::cerr << "Wrong archive selected for .json!" << std::endl;
+        return 1;
+    }
+#endif
     return 0;
 }